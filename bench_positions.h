@@ -0,0 +1,47 @@
+#ifndef BENCH_POSITIONS_H
+#define BENCH_POSITIONS_H
+
+#include "othello_board.h"
+#include <random>
+#include <vector>
+
+struct BenchPosition {
+    PackedBoard position;
+    int plies;
+};
+
+// Random playouts from the start position with a fixed seed, each stopped
+// minPlies..maxPlies moves in with the side to move able to play. Only raw
+// mt19937 output is used so the set is identical on every platform.
+inline std::vector<BenchPosition> benchPositions(int count, int minPlies, int maxPlies) {
+    std::mt19937 rng(20240601);
+    std::vector<BenchPosition> positions;
+    while((int)positions.size() < count) {
+        OthelloBoard board;
+        int player = OthelloBoard::BLACK;
+        int plies = minPlies + (int)(rng() % (maxPlies - minPlies + 1));
+        int played = 0;
+        while(played < plies) {
+            std::vector<int> moves;
+            for(int i = 11; i <= 88; ++i) {
+                if(board.legalMove(i, player)) moves.push_back(i);
+            }
+            if(moves.empty()) {
+                if(!board.hasLegalMoves(board.opponent(player))) break;
+                player = board.opponent(player);
+                continue;
+            }
+            board.makeMoveWithUndo(moves[rng() % moves.size()], player);
+            player = board.opponent(player);
+            played++;
+        }
+        if(played < plies || !board.hasLegalMoves(player)) continue;
+        BenchPosition bench;
+        bench.position = PackedBoard::pack(board, player);
+        bench.plies = played;
+        positions.push_back(bench);
+    }
+    return positions;
+}
+
+#endif // BENCH_POSITIONS_H
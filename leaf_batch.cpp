@@ -0,0 +1,115 @@
+#include "leaf_batch.h"
+#include "othello_board.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEAF_BATCH_X86 1
+#endif
+
+namespace {
+    const uint64_t Corners = 0x8100000000000081ULL;
+    // Edge squares other than corners (OthelloBoard::edgeControl)
+    const uint64_t Edges = 0x7E0000000000007EULL | 0x0001010101010100ULL | 0x0080808080808000ULL;
+    // Squares next to each corner (OthelloBoard::dangerousSquares)
+    const uint64_t CornerBits[4] = {1ULL << 0, 1ULL << 7, 1ULL << 56, 1ULL << 63};
+    const uint64_t NextToCorner[4] = {0x0000000000000302ULL, 0x000000000000C040ULL,
+                                      0x0203000000000000ULL, 0x40C0000000000000ULL};
+
+    // Moves of P against O along direction D
+    template<int D>
+    inline uint64_t movesAlong(uint64_t P, uint64_t O, uint64_t empty) {
+        uint64_t x = Bitboard::shift(P, D) & O;
+        for(int i = 0; i < 5; ++i) x |= Bitboard::shift(x, D) & O;
+        return Bitboard::shift(x, D) & empty;
+    }
+
+    inline uint64_t legalMoves(uint64_t P, uint64_t O) {
+        uint64_t empty = ~(P | O);
+        return movesAlong<0>(P, O, empty) | movesAlong<1>(P, O, empty) | movesAlong<2>(P, O, empty) |
+               movesAlong<3>(P, O, empty) | movesAlong<4>(P, O, empty) | movesAlong<5>(P, O, empty) |
+               movesAlong<6>(P, O, empty) | movesAlong<7>(P, O, empty);
+    }
+
+    // Discs of P joined to the board edge in direction D by a line of P's
+    // discs (OthelloBoard::isStableInDirection); Back is the opposite direction
+    template<int D, int Back>
+    inline uint64_t runToEdge(uint64_t P) {
+        uint64_t run = P & ~Bitboard::shift(~0ULL, Back); // Neighbor in D is off the board
+        for(int i = 0; i < 7; ++i) run |= P & Bitboard::shift(run, Back);
+        return run;
+    }
+
+    // OthelloBoard::isStable for every disc of P at once
+    inline uint64_t stableDiscs(uint64_t P) {
+        return P & (runToEdge<0, 1>(P) | runToEdge<1, 0>(P)) & (runToEdge<2, 3>(P) | runToEdge<3, 2>(P)) &
+               (runToEdge<4, 7>(P) | runToEdge<7, 4>(P)) & (runToEdge<5, 6>(P) | runToEdge<6, 5>(P));
+    }
+
+    inline int difference(uint64_t P, uint64_t O, uint64_t mask) {
+        return Bitboard::popcount(P & mask) - Bitboard::popcount(O & mask);
+    }
+
+    // One pass per feature so the mask passes vectorize across lanes
+    __attribute__((always_inline))
+    inline void evaluateLanes(const uint64_t* player, const uint64_t* opponent, int* score, int count) {
+        uint64_t playerMoves[LeafBatch::Capacity], opponentMoves[LeafBatch::Capacity];
+        uint64_t playerStable[LeafBatch::Capacity], opponentStable[LeafBatch::Capacity];
+        for(int i = 0; i < count; ++i) {
+            playerMoves[i] = legalMoves(player[i], opponent[i]);
+            opponentMoves[i] = legalMoves(opponent[i], player[i]);
+        }
+        for(int i = 0; i < count; ++i) {
+            playerStable[i] = stableDiscs(player[i]);
+            opponentStable[i] = stableDiscs(opponent[i]);
+        }
+        for(int i = 0; i < count; ++i) {
+            uint64_t P = player[i], O = opponent[i];
+            int pieces = Bitboard::popcount(P | O);
+            int mobility = (Bitboard::popcount(playerMoves[i]) - Bitboard::popcount(opponentMoves[i])) * 10;
+            int corners = difference(P, O, Corners) * 100;
+            int edges = difference(P, O, Edges) * 5;
+            int stability = (Bitboard::popcount(playerStable[i]) - Bitboard::popcount(opponentStable[i])) * 10;
+            int danger = 0;
+            for(int c = 0; c < 4; ++c) {
+                if(!(P & CornerBits[c])) danger -= difference(P, O, NextToCorner[c]) * 25;
+            }
+            int parity = (64 - pieces) % 2 == 1 ? 3 : -3;
+            // Game phase weights of OthelloBoard::advancedEvaluation
+            if(pieces <= 20) score[i] = mobility * 4 + corners * 3 + danger * 2;
+            else if(pieces <= 50) score[i] = mobility * 2 + stability + corners * 2 + edges + danger;
+            else score[i] = (Bitboard::popcount(P) - Bitboard::popcount(O)) * 3 + corners * 3 + stability + parity;
+        }
+    }
+
+    void evaluateDefault(const uint64_t* player, const uint64_t* opponent, int* score, int count) {
+        evaluateLanes(player, opponent, score, count);
+    }
+
+#ifdef LEAF_BATCH_X86
+    bool detectAvx2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    void evaluateAvx2(const uint64_t* player, const uint64_t* opponent, int* score, int count) {
+        evaluateLanes(player, opponent, score, count);
+    }
+#endif
+}
+
+void LeafBatch::evaluate() {
+#ifdef LEAF_BATCH_X86
+    static const bool avx2 = detectAvx2();
+    if(avx2) {
+        evaluateAvx2(player, opponent, score, count);
+        return;
+    }
+#endif
+    evaluateDefault(player, opponent, score, count);
+}
+
+int LeafBatch::evaluate(uint64_t P, uint64_t O) {
+    int score;
+    evaluateDefault(&P, &O, &score, 1);
+    return score;
+}
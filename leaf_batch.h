@@ -0,0 +1,39 @@
+#ifndef LEAF_BATCH_H
+#define LEAF_BATCH_H
+
+#include <cstdint>
+
+// A batch of positions scored together with the handcrafted evaluation.
+// Positions are stored as structure-of-arrays bitboards and every feature of
+// OthelloBoard::advancedEvaluation (mobility, corners, edges, stability,
+// X-squares, parity, discs) is computed with bit operations in one pass per
+// feature over all lanes. The passes vectorize, with AVX2 when the CPU has
+// it, and the scores equal advancedEvaluation exactly.
+class LeafBatch {
+public:
+    static const int Capacity = 64;
+
+    int count;
+    uint64_t player[Capacity];   // Discs of the side to move in each position
+    uint64_t opponent[Capacity];
+    int score[Capacity];         // Filled by evaluate(), for the side to move
+
+    LeafBatch() : count(0) {}
+
+    void clear() {
+        count = 0;
+    }
+
+    void add(uint64_t P, uint64_t O) {
+        player[count] = P;
+        opponent[count] = O;
+        count++;
+    }
+
+    void evaluate();
+
+    // Single-position form of the same evaluation
+    static int evaluate(uint64_t P, uint64_t O);
+};
+
+#endif // LEAF_BATCH_H
@@ -0,0 +1,55 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file (POSIX mmap)
+class MappedFile {
+private:
+    const unsigned char* bytes;
+    size_t length;
+
+public:
+    MappedFile() : bytes(nullptr), length(0) {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // An empty file opens successfully with data() == nullptr
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if(fd < 0) return false;
+        struct stat st;
+        if(fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        if(st.st_size > 0) {
+            void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapped == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            bytes = (const unsigned char*)mapped;
+            length = (size_t)st.st_size;
+        }
+        ::close(fd); // The mapping stays valid
+        return true;
+    }
+
+    void close() {
+        if(bytes) munmap((void*)bytes, length);
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,176 @@
+#include "nnue.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NNUE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Nnue {
+    namespace {
+        const char Magic[8] = {'O', 'T', 'H', 'N', 'N', 'U', 'E', '1'};
+
+        // Little-endian reader over the loaded file
+        struct Reader {
+            const unsigned char* data;
+            size_t size;
+            size_t offset;
+
+            bool has(size_t bytes) const { return offset + bytes <= size; }
+
+            uint32_t next(int bytes) {
+                uint32_t value = 0;
+                for(int i = 0; i < bytes; ++i) value |= (uint32_t)data[offset + i] << (8 * i);
+                offset += bytes;
+                return value;
+            }
+
+            void read(int16_t* out, size_t count) {
+                for(size_t i = 0; i < count; ++i) out[i] = (int16_t)next(2);
+            }
+
+            void read(int32_t* out, size_t count) {
+                for(size_t i = 0; i < count; ++i) out[i] = (int32_t)next(4);
+            }
+
+            void read(int8_t* out, size_t count) {
+                for(size_t i = 0; i < count; ++i) out[i] = (int8_t)next(1);
+            }
+        };
+
+        inline uint8_t clip(int value) {
+            return (uint8_t)(value < 0 ? 0 : value > ActivationMax ? ActivationMax : value);
+        }
+
+        // Dense layer activation: scaled, clipped sum
+        inline uint8_t activate(int32_t sum) {
+            return sum < 0 ? 0 : clip(sum >> WeightShift);
+        }
+
+        int32_t dotScalar(const uint8_t* input, const int8_t* weights, int count) {
+            int32_t sum = 0;
+            for(int i = 0; i < count; ++i) sum += input[i] * weights[i];
+            return sum;
+        }
+
+#ifdef NNUE_X86
+        bool detectAvx2() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        }
+
+        // count is a multiple of 32. Inputs are at most 127, so the pairwise
+        // u8 x s8 products in maddubs never saturate and results match dotScalar.
+        __attribute__((target("avx2")))
+        int32_t dotAvx2(const uint8_t* input, const int8_t* weights, int count) {
+            const __m256i ones = _mm256_set1_epi16(1);
+            __m256i sum = _mm256_setzero_si256();
+            for(int i = 0; i < count; i += 32) {
+                __m256i in = _mm256_loadu_si256((const __m256i*)(input + i));
+                __m256i w = _mm256_loadu_si256((const __m256i*)(weights + i));
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(in, w), ones));
+            }
+            __m128i total = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0x4E));
+            total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0xB1));
+            return _mm_cvtsi128_si32(total);
+        }
+
+        // Clip 64 int16 accumulator values into 64 uint8 inputs
+        __attribute__((target("avx2")))
+        void clipAvx2(const int16_t* values, uint8_t* out) {
+            const __m256i max = _mm256_set1_epi16(ActivationMax);
+            for(int i = 0; i < Hidden; i += 32) {
+                __m256i a = _mm256_min_epi16(_mm256_loadu_si256((const __m256i*)(values + i)), max);
+                __m256i b = _mm256_min_epi16(_mm256_loadu_si256((const __m256i*)(values + i + 16)), max);
+                __m256i packed = _mm256_packus_epi16(a, b); // Negatives saturate to 0
+                packed = _mm256_permute4x64_epi64(packed, 0xD8); // Undo the per-lane interleave
+                _mm256_storeu_si256((__m256i*)(out + i), packed);
+            }
+        }
+
+        __attribute__((target("avx2")))
+        int evaluateAvx2(const Network& network, const int16_t* own, const int16_t* opponent) {
+            uint8_t input[2 * Hidden], hidden1[L1], hidden2[L2];
+            clipAvx2(own, input);
+            clipAvx2(opponent, input + Hidden);
+            for(int o = 0; o < L1; ++o)
+                hidden1[o] = activate(network.l1Bias[o] + dotAvx2(input, network.l1Weights[o], 2 * Hidden));
+            for(int o = 0; o < L2; ++o)
+                hidden2[o] = activate(network.l2Bias[o] + dotAvx2(hidden1, network.l2Weights[o], L1));
+            int32_t output = network.outputBias + dotAvx2(hidden2, network.outputWeights, L2);
+            return output / OutputScale;
+        }
+#endif
+    }
+
+    bool avx2Enabled() {
+#ifdef NNUE_X86
+        static const bool enabled = detectAvx2();
+        return enabled;
+#else
+        return false;
+#endif
+    }
+
+    bool Network::load(const char* path) {
+        FILE* file = fopen(path, "rb");
+        if(!file) return false;
+        std::vector<unsigned char> bytes;
+        unsigned char chunk[65536];
+        size_t got;
+        while((got = fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + got);
+        bool readError = ferror(file) != 0;
+        fclose(file);
+        if(readError) return false;
+
+        const size_t payload = Hidden * 2 + Features * Hidden * 2 + L1 * 4 + L1 * 2 * Hidden +
+                               L2 * 4 + L2 * L1 + 4 + L2;
+        Reader reader = {bytes.data(), bytes.size(), 0};
+        if(bytes.size() != sizeof(Magic) + 12 + payload || memcmp(bytes.data(), Magic, sizeof(Magic)) != 0)
+            return false;
+        reader.offset = sizeof(Magic);
+        if(reader.next(4) != (uint32_t)Hidden || reader.next(4) != (uint32_t)L1 || reader.next(4) != (uint32_t)L2)
+            return false;
+        reader.read(featureBias, Hidden);
+        reader.read(&featureWeights[0][0], (size_t)Features * Hidden);
+        reader.read(l1Bias, L1);
+        reader.read(&l1Weights[0][0], (size_t)L1 * 2 * Hidden);
+        reader.read(l2Bias, L2);
+        reader.read(&l2Weights[0][0], (size_t)L2 * L1);
+        reader.read(&outputBias, 1);
+        reader.read(outputWeights, L2);
+        return reader.offset == reader.size;
+    }
+
+    int Network::evaluateScalar(const int16_t* own, const int16_t* opponent) const {
+        uint8_t input[2 * Hidden], hidden1[L1], hidden2[L2];
+        for(int i = 0; i < Hidden; ++i) {
+            input[i] = clip(own[i]);
+            input[Hidden + i] = clip(opponent[i]);
+        }
+        for(int o = 0; o < L1; ++o)
+            hidden1[o] = activate(l1Bias[o] + dotScalar(input, l1Weights[o], 2 * Hidden));
+        for(int o = 0; o < L2; ++o)
+            hidden2[o] = activate(l2Bias[o] + dotScalar(hidden1, l2Weights[o], L1));
+        int32_t output = outputBias + dotScalar(hidden2, outputWeights, L2);
+        return output / OutputScale;
+    }
+
+    int Network::evaluate(const int16_t* own, const int16_t* opponent) const {
+#ifdef NNUE_X86
+        if(avx2Enabled()) return evaluateAvx2(*this, own, opponent);
+#endif
+        return evaluateScalar(own, opponent);
+    }
+
+    void Accumulator::refresh(const Network& network, uint64_t black, uint64_t white) {
+        for(int view = 0; view < 2; ++view) {
+            for(int i = 0; i < Hidden; ++i) values[view][i] = network.featureBias[i];
+        }
+        for(uint64_t bits = black; bits; bits &= bits - 1) addDisc(network, __builtin_ctzll(bits), 0);
+        for(uint64_t bits = white; bits; bits &= bits - 1) addDisc(network, __builtin_ctzll(bits), 1);
+    }
+}
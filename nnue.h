@@ -0,0 +1,88 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Small quantized neural evaluator in the NNUE style. The first layer is an
+// accumulator over 128 features (own or opponent disc on each square) kept
+// for both perspectives and updated incrementally as discs are placed and
+// flipped. The clipped accumulators of the side to move and the opponent
+// feed two int8 dense layers and a linear output. The dense layers use AVX2
+// when the CPU supports it, with a scalar fallback giving identical results.
+namespace Nnue {
+    const int Squares = 64;
+    const int Features = 2 * Squares; // own disc on a square, then opponent disc
+    const int Hidden = 64;            // Accumulator width per perspective
+    const int L1 = 32;
+    const int L2 = 32;
+    const int ActivationMax = 127;    // Clipped ReLU range [0, 127] as uint8
+    const int WeightShift = 6;        // Dense layer sums are scaled by 2^-6
+    const int OutputScale = 16;       // Network output / OutputScale = evaluation
+
+    // Weight file: the magic "OTHNNUE1", Hidden, L1 and L2 as little-endian
+    // uint32 (checked against the constants above), then every array below
+    // in declaration order, little-endian, rows contiguous.
+    struct Network {
+        int16_t featureBias[Hidden];
+        int16_t featureWeights[Features][Hidden];
+        int32_t l1Bias[L1];
+        int8_t l1Weights[L1][2 * Hidden];
+        int32_t l2Bias[L2];
+        int8_t l2Weights[L2][L1];
+        int32_t outputBias;
+        int8_t outputWeights[L2];
+
+        // False if the file is missing, truncated or has other dimensions
+        bool load(const char* path);
+
+        // Evaluation for the side whose accumulator is own
+        int evaluate(const int16_t* own, const int16_t* opponent) const;
+        int evaluateScalar(const int16_t* own, const int16_t* opponent) const;
+    };
+
+    // True if evaluate runs the AVX2 kernels on this CPU
+    bool avx2Enabled();
+
+    // First-layer outputs for both perspectives: values[0] sees black's discs
+    // as own, values[1] white's. Colors are 0 black, 1 white.
+    struct Accumulator {
+        int16_t values[2][Hidden];
+
+        void refresh(const Network& network, uint64_t black, uint64_t white);
+
+        void addDisc(const Network& network, int bit, int color) {
+            add(values[0], network.featureWeights[feature(0, color, bit)]);
+            add(values[1], network.featureWeights[feature(1, color, bit)]);
+        }
+
+        void removeDisc(const Network& network, int bit, int color) {
+            subtract(values[0], network.featureWeights[feature(0, color, bit)]);
+            subtract(values[1], network.featureWeights[feature(1, color, bit)]);
+        }
+
+        // Disc at bit changes to color
+        void flipDisc(const Network& network, int bit, int color) {
+            for(int view = 0; view < 2; ++view) {
+                add(values[view], network.featureWeights[feature(view, color, bit)]);
+                subtract(values[view], network.featureWeights[feature(view, 1 - color, bit)]);
+            }
+        }
+
+        static int feature(int view, int color, int bit) {
+            return (color == view ? 0 : Squares) + bit;
+        }
+
+    private:
+        // Plain loops: the compiler vectorizes them
+        static void add(int16_t* values, const int16_t* weights) {
+            for(int i = 0; i < Hidden; ++i) values[i] = (int16_t)(values[i] + weights[i]);
+        }
+
+        static void subtract(int16_t* values, const int16_t* weights) {
+            for(int i = 0; i < Hidden; ++i) values[i] = (int16_t)(values[i] - weights[i]);
+        }
+    };
+}
+
+#endif // NNUE_H
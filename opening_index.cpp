@@ -0,0 +1,266 @@
+#include "opening_index.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <thread>
+
+namespace {
+    const size_t BufferRecords = 1 << 16;
+    const uint32_t ChunkGames = 1024; // Games claimed by an import worker at a time
+
+    void encode(unsigned char* out, uint64_t value, int bytes) {
+        for(int i = 0; i < bytes; ++i) out[i] = (unsigned char)(value >> (8 * i));
+    }
+
+    uint64_t decode(const unsigned char* in, int bytes) {
+        uint64_t value = 0;
+        for(int i = 0; i < bytes; ++i) value |= (uint64_t)in[i] << (8 * i);
+        return value;
+    }
+
+    // Per-thread open-addressing table of (key, move) -> games/points.
+    // Capacity doubles at half load, so inserts don't allocate per position.
+    class StatsTable {
+    private:
+        std::vector<OpeningRecord> slots; // games == 0 marks an empty slot
+        size_t used;
+
+        static size_t slotFor(uint64_t key, int move, size_t mask) {
+            return (size_t)((key ^ (uint64_t)move * 0x9E3779B97F4A7C15ULL) >> 7) & mask;
+        }
+
+        void insert(const OpeningRecord& record) {
+            size_t mask = slots.size() - 1;
+            size_t i = slotFor(record.key, record.move, mask);
+            while(slots[i].games) i = (i + 1) & mask;
+            slots[i] = record;
+        }
+
+        void grow() {
+            std::vector<OpeningRecord> old(slots.size() * 2, OpeningRecord());
+            old.swap(slots);
+            for(const OpeningRecord& record : old) {
+                if(record.games) insert(record);
+            }
+        }
+
+    public:
+        StatsTable() : slots(1 << 16, OpeningRecord()), used(0) {}
+
+        void add(uint64_t key, int move, uint32_t points) {
+            if(2 * (used + 1) > slots.size()) grow();
+            size_t mask = slots.size() - 1;
+            size_t i = slotFor(key, move, mask);
+            while(slots[i].games && (slots[i].key != key || slots[i].move != move)) i = (i + 1) & mask;
+            OpeningRecord& slot = slots[i];
+            if(!slot.games) {
+                slot.key = key;
+                slot.move = move;
+                slot.points = 0;
+                ++used;
+            }
+            slot.games++;
+            slot.points += points;
+        }
+
+        // Sorted records; the table is emptied
+        std::vector<OpeningRecord> release() {
+            std::vector<OpeningRecord> records;
+            records.reserve(used);
+            for(const OpeningRecord& record : slots) {
+                if(record.games) records.push_back(record);
+            }
+            std::vector<OpeningRecord>().swap(slots);
+            used = 0;
+            std::sort(records.begin(), records.end());
+            return records;
+        }
+    };
+
+    struct Chunk {
+        size_t file;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct WorkerResult {
+        std::vector<OpeningRecord> records;
+        uint64_t games = 0;
+        uint64_t badGames = 0;
+    };
+
+    // Positions of one game, committed only once the whole game replays
+    struct GameVisit {
+        uint64_t key;
+        int move;   // Canonical orientation, 0 at the final position
+        int player;
+    };
+
+    void importWorker(const std::vector<const WthorFile*>& files, const std::vector<Chunk>& chunks,
+                      std::atomic<size_t>& nextChunk, int maxPlies, WorkerResult& result) {
+        StatsTable table;
+        GameVisit visits[Wthor::MaxMoves + 1];
+        for(size_t c = nextChunk++; c < chunks.size(); c = nextChunk++) {
+            const Chunk& chunk = chunks[c];
+            for(uint32_t g = chunk.first; g < chunk.first + chunk.count; ++g) {
+                WthorGame game = files[chunk.file]->game(g);
+                int count = 0;
+                bool ok = Wthor::replayGame(game, [&](uint64_t black, uint64_t white, int player, int move) {
+                    if(count > maxPlies) return;
+                    int sym;
+                    GameVisit& visit = visits[count++];
+                    visit.key = Symmetry::canonicalKey(black, white, player, sym);
+                    visit.move = move ? Symmetry::canonicalSquare(black, white, sym, move) : 0;
+                    visit.player = player;
+                });
+                if(!ok) {
+                    result.badGames++;
+                    continue;
+                }
+                result.games++;
+                int blackPoints = game.blackPoints();
+                for(int i = 0; i < count; ++i) {
+                    uint32_t points = visits[i].player == OthelloBoard::BLACK ? blackPoints : 2 - blackPoints;
+                    table.add(visits[i].key, 0, points);
+                    if(visits[i].move) table.add(visits[i].key, visits[i].move, points);
+                }
+            }
+        }
+        result.records = table.release();
+    }
+
+    struct MergeHead {
+        OpeningRecord record;
+        size_t source;
+        size_t next;
+        bool operator>(const MergeHead& other) const {
+            return other.record < record;
+        }
+    };
+
+    // K-way merge of the sorted per-thread records, summing equal (key, move)
+    std::vector<OpeningRecord> mergeResults(std::vector<WorkerResult>& results) {
+        if(results.size() == 1) return std::move(results[0].records);
+        std::priority_queue<MergeHead, std::vector<MergeHead>, std::greater<MergeHead>> heads;
+        size_t total = 0;
+        for(size_t i = 0; i < results.size(); ++i) {
+            total += results[i].records.size();
+            if(!results[i].records.empty()) heads.push(MergeHead{results[i].records[0], i, 1});
+        }
+        std::vector<OpeningRecord> merged;
+        merged.reserve(total);
+        while(!heads.empty()) {
+            MergeHead head = heads.top();
+            heads.pop();
+            if(!merged.empty() && merged.back().key == head.record.key && merged.back().move == head.record.move) {
+                merged.back().games += head.record.games;
+                merged.back().points += head.record.points;
+            } else {
+                merged.push_back(head.record);
+            }
+            const std::vector<OpeningRecord>& source = results[head.source].records;
+            if(head.next < source.size()) heads.push(MergeHead{source[head.next], head.source, head.next + 1});
+        }
+        return merged;
+    }
+}
+
+bool writeOpeningIndex(const char* path, const std::vector<OpeningRecord>& records) {
+    FILE* file = fopen(path, "wb");
+    if(!file) return false;
+    bool ok = fwrite(OpeningIndexFile::Magic, 1, sizeof(OpeningIndexFile::Magic), file) == sizeof(OpeningIndexFile::Magic);
+    std::vector<unsigned char> buffer(BufferRecords * OpeningIndexFile::RecordSize);
+    size_t used = 0;
+    for(size_t i = 0; i < records.size() && ok; ++i) {
+        unsigned char* out = &buffer[used];
+        encode(out, records[i].key, 8);
+        encode(out + 8, (uint32_t)records[i].move, 4);
+        encode(out + 12, records[i].games, 4);
+        encode(out + 16, records[i].points, 4);
+        used += OpeningIndexFile::RecordSize;
+        if(used == buffer.size()) {
+            ok = fwrite(buffer.data(), 1, used, file) == used;
+            used = 0;
+        }
+    }
+    if(ok && used) ok = fwrite(buffer.data(), 1, used, file) == used;
+    if(fclose(file) != 0) ok = false;
+    return ok;
+}
+
+bool OpeningIndex::open(const char* path) {
+    close();
+    if(!file.open(path)) return false;
+    if(file.size() < OpeningIndexFile::HeaderSize ||
+       memcmp(file.data(), OpeningIndexFile::Magic, sizeof(OpeningIndexFile::Magic)) != 0 ||
+       (file.size() - OpeningIndexFile::HeaderSize) % OpeningIndexFile::RecordSize != 0) {
+        close();
+        return false;
+    }
+    records = (file.size() - OpeningIndexFile::HeaderSize) / OpeningIndexFile::RecordSize;
+    return true;
+}
+
+void OpeningIndex::close() {
+    file.close();
+    records = 0;
+}
+
+OpeningRecord OpeningIndex::record(size_t index) const {
+    const unsigned char* in = file.data() + OpeningIndexFile::HeaderSize + index * OpeningIndexFile::RecordSize;
+    OpeningRecord result;
+    result.key = decode(in, 8);
+    result.move = (int)decode(in + 8, 4);
+    result.games = (uint32_t)decode(in + 12, 4);
+    result.points = (uint32_t)decode(in + 16, 4);
+    return result;
+}
+
+bool OpeningIndex::lookup(uint64_t key, std::vector<OpeningRecord>& out) const {
+    // Lower bound on key
+    size_t lo = 0, hi = records;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(record(mid).key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    bool found = false;
+    for(size_t i = lo; i < records; ++i) {
+        OpeningRecord entry = record(i);
+        if(entry.key != key) break;
+        out.push_back(entry);
+        found = true;
+    }
+    return found;
+}
+
+std::vector<OpeningRecord> importGames(const std::vector<const WthorFile*>& files, int threads, int maxPlies,
+                                       ImportStats& stats) {
+    std::vector<Chunk> chunks;
+    for(size_t f = 0; f < files.size(); ++f) {
+        for(uint32_t first = 0; first < files[f]->count(); first += ChunkGames) {
+            chunks.push_back(Chunk{f, first, std::min(ChunkGames, files[f]->count() - first)});
+        }
+    }
+
+    if(threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, (int)std::max<size_t>(1, chunks.size())));
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextChunk(0);
+    for(int t = 0; t < threads; ++t) {
+        workers.emplace_back(importWorker, std::cref(files), std::cref(chunks), std::ref(nextChunk),
+                             maxPlies, std::ref(results[t]));
+    }
+    for(std::thread& worker : workers) worker.join();
+
+    stats = ImportStats();
+    stats.threads = threads;
+    for(const WorkerResult& result : results) {
+        stats.games += result.games;
+        stats.badGames += result.badGames;
+    }
+    return mergeResults(results);
+}
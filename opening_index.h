@@ -0,0 +1,74 @@
+#ifndef OPENING_INDEX_H
+#define OPENING_INDEX_H
+
+#include "othello_board.h"
+#include "mapped_file.h"
+#include "wthor.h"
+#include <vector>
+
+// Position-frequency index built from game databases. Positions are keyed
+// by Symmetry::canonicalKey. For each key there is one record with move 0
+// counting every game that reached the position, plus one record per next
+// move played from it, with the move stored in the canonical orientation
+// (map it back with Symmetry::inverseSquare). Scores are half-points for
+// the side to move: 2 per win, 1 per draw.
+struct OpeningRecord {
+    uint64_t key;
+    int move;
+    uint32_t games;
+    uint32_t points;
+
+    double winRate() const {
+        return games ? points / (2.0 * games) : 0.0;
+    }
+
+    bool operator<(const OpeningRecord& other) const {
+        if(key != other.key) return key < other.key;
+        return move < other.move;
+    }
+};
+
+// File layout: an 8-byte magic followed by 20-byte little-endian records
+// (key u64, move u32, games u32, points u32) sorted by key, then move.
+namespace OpeningIndexFile {
+    const char Magic[8] = {'O', 'T', 'H', 'I', 'D', 'X', '0', '1'};
+    const size_t HeaderSize = 8;
+    const size_t RecordSize = 20;
+}
+
+struct ImportStats {
+    uint64_t games = 0;
+    uint64_t badGames = 0; // Rejected at the first illegal or malformed move
+    int threads = 0;       // Workers actually used
+};
+
+// Replays every game of files on threads workers (<= 0: every core) and
+// returns the records for positions up to maxPlies moves in, sorted and
+// merged. Games are split over the workers in chunks; the result doesn't
+// depend on the thread count.
+std::vector<OpeningRecord> importGames(const std::vector<const WthorFile*>& files, int threads, int maxPlies,
+                                       ImportStats& stats);
+
+// Writes records, which must already be sorted and merged
+bool writeOpeningIndex(const char* path, const std::vector<OpeningRecord>& records);
+
+// Memory-mapped index with binary-search lookups
+class OpeningIndex {
+private:
+    MappedFile file;
+    size_t records;
+
+public:
+    OpeningIndex() : records(0) {}
+
+    bool open(const char* path);
+    void close();
+
+    size_t size() const { return records; }
+    OpeningRecord record(size_t index) const;
+
+    // Appends all records for key (position total first); false if absent
+    bool lookup(uint64_t key, std::vector<OpeningRecord>& out) const;
+};
+
+#endif // OPENING_INDEX_H
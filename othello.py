@@ -3,11 +3,17 @@ import sys
 import copy
 from typing import List, Tuple, Optional
 
+try:
+    import othello_engine  # Native C++ engine (libothello.so, built with `make lib`)
+except (ImportError, OSError):
+    othello_engine = None
+
 # --- Constants ---
 # Game settings
 BOARD_DIM = 8  # Playable board dimension (8x8)
 ARRAY_DIM = BOARD_DIM + 2  # Internal array dimension including border (10x10)
 PLY_DEPTH = 5  # AI search depth 
+AI_TIME_LIMIT_MS = 2000  # Time limit per move when the native engine is used
 
 # Colors
 COLOR_BOARD_BG = (0, 128, 0)  # Green
@@ -242,6 +248,7 @@ class AIPlayer:
     def __init__(self, ai_player: int, depth: int = PLY_DEPTH):
         self.ai_player = ai_player
         self.depth = depth
+        self.engine = othello_engine.Engine() if othello_engine else None
 
     def get_best_move(self, game: OthelloGame) -> Optional[int]:
         """
@@ -254,6 +261,11 @@ class AIPlayer:
              return None # Should not happen if logic is correct
 
         print(f"AI ({self.ai_player}) is thinking...")
+        if self.engine:
+            best_move = self.engine.search(game.board, self.ai_player, self.depth, AI_TIME_LIMIT_MS)
+            print(f"AI chooses move index {best_move} (native engine)")
+            return best_move
+
         score, best_move = self._alphabeta(
             game.board, # Pass a copy of the board state
             self.ai_player,
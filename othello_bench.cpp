@@ -0,0 +1,254 @@
+// Search benchmark: runs iterative deepening on a fixed, reproducible set of
+// positions and reports nodes and time per root driver. "othello_bench bench"
+// prints the total node count as a signature: it only changes when the
+// search itself changes, so builds can be compared on any machine.
+#include "bench_positions.h"
+#include "othello_engine.h"
+#include "parallel_solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    struct DriverResult {
+        uint64_t nodes;
+        uint64_t qnodes;
+        uint64_t evalProbes;
+        uint64_t evalHits;
+        double seconds;
+    };
+
+    DriverResult runDriver(const std::vector<BenchPosition>& positions, int depth, uint64_t nodeLimit,
+                           std::shared_ptr<const Nnue::Network> network,
+                           OthelloEngine::SearchDriver driver, bool verbose) {
+        DriverResult result = {0, 0, 0, 0, 0.0};
+        for(size_t i = 0; i < positions.size(); ++i) {
+            OthelloEngine engine;
+            int player;
+            positions[i].position.unpack(engine.board, player);
+            if(network) engine.setNetwork(network);
+            engine.driver = driver;
+            engine.timeManager.enableTimeLimit(false);
+            engine.timeManager.setNodeLimit(nodeLimit);
+            engine.transTable.clear(); // Allocate the table outside the timed search
+
+            auto start = std::chrono::steady_clock::now();
+            int move = engine.iterativeDeepening(player, depth);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            result.nodes += engine.stats.nodes;
+            result.qnodes += engine.stats.qnodes;
+            result.evalProbes += engine.stats.evalProbes;
+            result.evalHits += engine.stats.evalHits;
+            result.seconds += seconds;
+            if(verbose) {
+                printf("  position %2zu (ply %2d): move %2d  nodes %10llu  qnodes %10llu  %8.3fs\n",
+                       i + 1, positions[i].plies, move, (unsigned long long)engine.stats.nodes,
+                       (unsigned long long)engine.stats.qnodes, seconds);
+            }
+        }
+        return result;
+    }
+
+    // Endgame solves at a fixed number of empties: WLD against exact, with
+    // the serial solver or, given more than one thread, the parallel one
+    void runSolves(const std::vector<BenchPosition>& positions, int threads, bool verbose) {
+        const char* names[2] = {"exact", "wld"};
+        std::shared_ptr<ParallelSolver> solver;
+        if(threads > 1) solver = std::make_shared<ParallelSolver>(threads);
+        for(int wld = 0; wld < 2; ++wld) {
+            uint64_t nodes = 0;
+            double total = 0.0;
+            for(size_t i = 0; i < positions.size(); ++i) {
+                OthelloEngine engine;
+                int player;
+                positions[i].position.unpack(engine.board, player);
+                engine.timeManager.enableTimeLimit(false);
+                if(solver) {
+                    solver->clear();
+                    engine.endgameSolver = solver;
+                }
+
+                auto start = std::chrono::steady_clock::now();
+                SolveResult result = engine.solve(player, wld);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                nodes += engine.stats.solveNodes;
+                total += seconds;
+                if(verbose) {
+                    printf("  %-5s position %2zu: score %3d  move %2d  nodes %12llu  %8.3fs\n", names[wld],
+                           i + 1, result.score, result.move, (unsigned long long)engine.stats.solveNodes, seconds);
+                }
+            }
+            printf("%-10s nodes %12llu  time %8.3fs  nps %10.0f\n", names[wld], (unsigned long long)nodes,
+                   total, total > 0 ? nodes / total : 0.0);
+        }
+    }
+
+    // Multi-PV cost: analyze(numPV) against numPV separate searches, each
+    // with the moves already found excluded at the root
+    void runMultiPv(const std::vector<BenchPosition>& positions, int depth, int numPV, bool verbose) {
+        uint64_t analyzeNodes = 0, separateNodes = 0;
+        int agree = 0;
+        for(size_t i = 0; i < positions.size(); ++i) {
+            OthelloEngine engine;
+            int player;
+            positions[i].position.unpack(engine.board, player);
+            engine.timeManager.enableTimeLimit(false);
+            std::vector<RootLine> lines = engine.analyze(player, depth, numPV);
+            uint64_t multi = engine.stats.nodes + engine.stats.qnodes;
+
+            uint64_t separate = 0;
+            std::vector<int> top;
+            int searches = std::min(numPV, (int)lines.size());
+            for(int k = 0; k < searches; ++k) {
+                int move = engine.iterativeDeepening(player, depth);
+                separate += engine.stats.nodes + engine.stats.qnodes;
+                if(move == -1) break;
+                top.push_back(move);
+                engine.excludedRootMoves |= 1ULL << Bitboard::squareToBit(move);
+            }
+            bool same = (int)top.size() == searches;
+            for(int k = 0; k < searches && same; ++k) {
+                same = std::find(top.begin(), top.end(), lines[k].move) != top.end();
+            }
+            agree += same;
+            analyzeNodes += multi;
+            separateNodes += separate;
+            if(verbose) {
+                printf("  position %2zu (ply %2d): analyze %10llu  separate %10llu  ratio %.3f%s\n", i + 1,
+                       positions[i].plies, (unsigned long long)multi, (unsigned long long)separate,
+                       separate ? (double)multi / separate : 0.0, same ? "" : "  (different top moves)");
+            }
+        }
+        printf("multi-pv %d  analyze nodes %12llu  separate nodes %12llu  ratio %.3f  same top moves %d/%zu\n",
+               numPV, (unsigned long long)analyzeNodes, (unsigned long long)separateNodes,
+               separateNodes ? (double)analyzeNodes / separateNodes : 0.0, agree, positions.size());
+    }
+
+    void printResult(const char* name, const DriverResult& result) {
+        uint64_t total = result.nodes + result.qnodes;
+        printf("%-10s nodes %12llu  qnodes %12llu  time %8.3fs  nps %10.0f", name,
+               (unsigned long long)result.nodes, (unsigned long long)result.qnodes,
+               result.seconds, result.seconds > 0 ? total / result.seconds : 0.0);
+        if(result.evalProbes) printf("  eval hits %5.1f%%", 100.0 * result.evalHits / result.evalProbes); // Network only
+        printf("\n");
+    }
+
+    void printSignature(const char* name, const DriverResult& result) {
+        uint64_t total = result.nodes + result.qnodes;
+        printf("%-10s signature %llu  time %.3fs  nps %.0f\n", name, (unsigned long long)total,
+               result.seconds, result.seconds > 0 ? total / result.seconds : 0.0);
+    }
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_bench [options] [bench]\n"
+            "  bench      print the node signature and NPS (default driver aspiration)\n"
+            "  -d DEPTH   search depth (default 7)\n"
+            "  -N NODES   node budget per position (default unlimited)\n"
+            "  -W FILE    evaluate with this neural network weight file\n"
+            "  -n COUNT   number of benchmark positions (default 12)\n"
+            "  -D DRIVER  aspiration, mtdf or both (default both)\n"
+            "  -E EMPTIES solve endgames with this many empties (exact and WLD) instead\n"
+            "  -j THREADS threads for -E solves (default 1, 0 = every core)\n"
+            "  -K LINES   compare multi-PV analysis of LINES moves with LINES separate searches\n"
+            "  -v         per-position output\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int depth = 7;
+    int count = 12;
+    bool runAspiration = true, runMtdf = true;
+    bool verbose = false;
+    int empties = 0;
+    int threads = 1;
+    int numPV = 0;
+    uint64_t nodeLimit = 0;
+    bool driverSet = false;
+    const char* weights = nullptr;
+    int opt;
+    while((opt = getopt(argc, argv, "d:n:N:W:D:E:j:K:vh")) != -1) {
+        switch(opt) {
+            case 'd': depth = std::max(1, atoi(optarg)); break;
+            case 'n': count = std::max(1, atoi(optarg)); break;
+            case 'N': nodeLimit = strtoull(optarg, nullptr, 10); break;
+            case 'W': weights = optarg; break;
+            case 'D':
+                driverSet = true;
+                runAspiration = !strcmp(optarg, "aspiration") || !strcmp(optarg, "both");
+                runMtdf = !strcmp(optarg, "mtdf") || !strcmp(optarg, "both");
+                if(!runAspiration && !runMtdf) {
+                    usage();
+                    return 1;
+                }
+                break;
+            case 'E': empties = std::min(40, std::max(1, atoi(optarg))); break;
+            case 'j': threads = std::max(0, atoi(optarg)); break;
+            case 'K': numPV = std::max(1, atoi(optarg)); break;
+            case 'v': verbose = true; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    bool signature = optind < argc && !strcmp(argv[optind], "bench");
+    if(optind < argc && !signature) {
+        usage();
+        return 1;
+    }
+    if(signature && !driverSet) runMtdf = false;
+
+    Zobrist::init();
+    std::shared_ptr<Nnue::Network> network;
+    if(weights) {
+        network.reset(new Nnue::Network());
+        if(!network->load(weights)) {
+            fprintf(stderr, "othello_bench: cannot load network %s\n", weights);
+            return 1;
+        }
+        printf("network %s (%s)\n", weights, Nnue::avx2Enabled() ? "avx2" : "scalar");
+    }
+    if(empties) {
+        std::vector<BenchPosition> positions = benchPositions(count, 60 - empties, 60 - empties);
+        if(threads == 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+        printf("%d positions, %d empties, %d thread%s\n", count, empties, threads, threads == 1 ? "" : "s");
+        runSolves(positions, threads, verbose);
+        return 0;
+    }
+
+    std::vector<BenchPosition> positions = benchPositions(count, 8, 40); // 8..40 plies into the game
+    printf("%d positions, depth %d\n", count, depth);
+    if(numPV) {
+        runMultiPv(positions, depth, numPV, verbose);
+        return 0;
+    }
+
+    DriverResult aspiration = {0, 0, 0, 0, 0.0}, mtdf = {0, 0, 0, 0, 0.0};
+    if(runAspiration) {
+        if(verbose) printf("aspiration:\n");
+        aspiration = runDriver(positions, depth, nodeLimit, network, OthelloEngine::ASPIRATION, verbose);
+    }
+    if(runMtdf) {
+        if(verbose) printf("mtdf:\n");
+        mtdf = runDriver(positions, depth, nodeLimit, network, OthelloEngine::MTDF, verbose);
+    }
+    if(signature) {
+        if(runAspiration) printSignature("aspiration", aspiration);
+        if(runMtdf) printSignature("mtdf", mtdf);
+        return 0;
+    }
+    if(runAspiration) printResult("aspiration", aspiration);
+    if(runMtdf) printResult("mtdf", mtdf);
+    if(runAspiration && runMtdf && aspiration.nodes + aspiration.qnodes > 0) {
+        double ratio = (double)(mtdf.nodes + mtdf.qnodes) / (aspiration.nodes + aspiration.qnodes);
+        printf("mtdf/aspiration total nodes: %.3f\n", ratio);
+    }
+    return 0;
+}
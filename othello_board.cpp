@@ -0,0 +1,54 @@
+#include "othello_board.h"
+#include <random>
+
+// Zobrist hashing for fast position keys
+namespace Zobrist {
+    uint64_t squarePiece[100][4];
+    uint64_t sideToMove[2];
+    bool initialized = false;
+    
+    void init() {
+        if (initialized) return;
+        
+        std::mt19937_64 rng(0xC0FFEE); // Fixed seed for reproducibility  
+        for (int i = 0; i < 100; ++i) {
+            for (int piece = 0; piece < 4; ++piece) {
+                squarePiece[i][piece] = rng();
+            }
+        }
+        sideToMove[0] = rng(); // BLACK-1
+        sideToMove[1] = rng(); // WHITE-1
+        initialized = true;
+    }
+}
+
+const int OthelloBoard::AllDirections[8] = {-11, -10, -9, -1, 1, 9, 10, 11};
+const int OthelloBoard::weights[100] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 120, -20, 20, 5, 5, 20, -20, 120, 0,
+    0, -20, -40, -5, -5, -5, -5, -40, -20, 0,
+    0, 20, -5, 15, 3, 3, 15, -5, 20, 0,
+    0, 5, -5, 3, 3, 3, 3, -5, 5, 0,
+    0, 5, -5, 3, 3, 3, 3, -5, 5, 0,
+    0, 20, -5, 15, 3, 3, 15, -5, 20, 0,
+    0, -20, -40, -5, -5, -5, -5, -40, -20, 0,
+    0, 120, -20, 20, 5, 5, 20, -20, 120, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+// Fast flip counting for move ordering
+int countFlipsForMove(const OthelloBoard& board, int move, int player) {
+    int flips = 0;
+    for(int k = 0; k < 8; ++k) {
+        int dir = OthelloBoard::AllDirections[k];
+        int pos = move + dir;
+        int run = 0;
+        if(board.board[pos] != board.opponent(player)) continue;
+        while(board.board[pos] == board.opponent(player)) {
+            ++run;
+            pos += dir;
+        }
+        if(board.board[pos] == player) flips += run;
+    }
+    return flips;
+}
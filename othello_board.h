@@ -0,0 +1,637 @@
+#ifndef OTHELLO_BOARD_H
+#define OTHELLO_BOARD_H
+
+#include "nnue.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// Zobrist hashing for fast position keys
+namespace Zobrist {
+    extern uint64_t squarePiece[100][4]; // [square][piece] - EMPTY, BLACK, WHITE, OUTER
+    extern uint64_t sideToMove[2];       // [BLACK/WHITE-1] for side to move
+
+    void init();
+}
+
+// 8x8 bitboards: bit (row-1)*8 + (col-1) for mailbox square row*10 + col
+namespace Bitboard {
+    inline int squareToBit(int square) {
+        return (square / 10 - 1) * 8 + (square % 10 - 1);
+    }
+
+    inline int bitToSquare(int bit) {
+        return (bit / 8 + 1) * 10 + (bit % 8 + 1);
+    }
+
+    // Mirror rows: row r <-> row 9-r
+    inline uint64_t flipVertical(uint64_t x) {
+        return __builtin_bswap64(x);
+    }
+
+    // Mirror columns: col c <-> col 9-c
+    inline uint64_t mirrorHorizontal(uint64_t x) {
+        const uint64_t k1 = 0x5555555555555555ULL;
+        const uint64_t k2 = 0x3333333333333333ULL;
+        const uint64_t k4 = 0x0f0f0f0f0f0f0f0fULL;
+        x = ((x >> 1) & k1) | ((x & k1) << 1);
+        x = ((x >> 2) & k2) | ((x & k2) << 2);
+        x = ((x >> 4) & k4) | ((x & k4) << 4);
+        return x;
+    }
+
+    // Transpose: (row, col) <-> (col, row)
+    inline uint64_t flipDiagonal(uint64_t x) {
+        const uint64_t k1 = 0x5500550055005500ULL;
+        const uint64_t k2 = 0x3333000033330000ULL;
+        const uint64_t k4 = 0x0f0f0f0f00000000ULL;
+        uint64_t t;
+        t = k4 & (x ^ (x << 28)); x ^= t ^ (t >> 28);
+        t = k2 & (x ^ (x << 14)); x ^= t ^ (t >> 14);
+        t = k1 & (x ^ (x << 7));  x ^= t ^ (t >> 7);
+        return x;
+    }
+
+    inline int popcount(uint64_t x) {
+        return __builtin_popcountll(x);
+    }
+
+    // Shift one step in direction d (0-7: W, E, N, S, NW, NE, SW, SE),
+    // dropping bits that would wrap around a board edge
+    inline uint64_t shift(uint64_t x, int d) {
+        const uint64_t notColA = 0xfefefefefefefefeULL; // Clears col 1 after an eastward shift
+        const uint64_t notColH = 0x7f7f7f7f7f7f7f7fULL; // Clears col 8 after a westward shift
+        switch(d) {
+            case 0: return (x >> 1) & notColH;
+            case 1: return (x << 1) & notColA;
+            case 2: return x >> 8;
+            case 3: return x << 8;
+            case 4: return (x >> 9) & notColH;
+            case 5: return (x >> 7) & notColA;
+            case 6: return (x << 7) & notColH;
+            default: return (x << 9) & notColA;
+        }
+    }
+
+    // Legal moves for the player owning P against O
+    inline uint64_t legalMoves(uint64_t P, uint64_t O) {
+        uint64_t empty = ~(P | O);
+        uint64_t moves = 0;
+        for(int d = 0; d < 8; ++d) {
+            uint64_t x = shift(P, d) & O;
+            x |= shift(x, d) & O;
+            x |= shift(x, d) & O;
+            x |= shift(x, d) & O;
+            x |= shift(x, d) & O;
+            x |= shift(x, d) & O;
+            moves |= shift(x, d) & empty;
+        }
+        return moves;
+    }
+
+    // Discs flipped when the owner of P plays on bit
+    inline uint64_t flips(uint64_t P, uint64_t O, int bit) {
+        uint64_t flipped = 0;
+        uint64_t move = 1ULL << bit;
+        for(int d = 0; d < 8; ++d) {
+            uint64_t run = 0;
+            uint64_t x = shift(move, d);
+            while(x & O) {
+                run |= x;
+                x = shift(x, d);
+            }
+            if(x & P) flipped |= run;
+        }
+        return flipped;
+    }
+
+    // Cheap 64-bit hash of a bitboard position (splitmix64 finalizer)
+    inline uint64_t hash(uint64_t P, uint64_t O) {
+        uint64_t x = P * 0x9e3779b97f4a7c15ULL ^ (O + 0x632be59bd9b4e019ULL) * 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 31;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 29;
+        return x;
+    }
+}
+
+// The 8 board symmetries. A symmetry index is a bit set applied in order:
+// bit 2 = transpose, bit 0 = mirror columns, bit 1 = mirror rows.
+namespace Symmetry {
+    const int Count = 8;
+
+    inline uint64_t transform(uint64_t x, int sym) {
+        if(sym & 4) x = Bitboard::flipDiagonal(x);
+        if(sym & 1) x = Bitboard::mirrorHorizontal(x);
+        if(sym & 2) x = Bitboard::flipVertical(x);
+        return x;
+    }
+
+    // Map a mailbox square (or -1 for "no move") into the transformed orientation
+    inline int transformSquare(int square, int sym) {
+        if(square < 0) return square;
+        int row = square / 10, col = square % 10;
+        if(sym & 4) std::swap(row, col);
+        if(sym & 1) col = 9 - col;
+        if(sym & 2) row = 9 - row;
+        return row * 10 + col;
+    }
+
+    // Map a square from the transformed orientation back to the original one
+    inline int inverseSquare(int square, int sym) {
+        if(square < 0) return square;
+        int row = square / 10, col = square % 10;
+        if(sym & 2) row = 9 - row;
+        if(sym & 1) col = 9 - col;
+        if(sym & 4) std::swap(row, col);
+        return row * 10 + col;
+    }
+
+    // Pick the orientation whose (black, white) bitboards compare smallest.
+    // Symmetric positions map to the same canonical bitboards.
+    inline int canonical(uint64_t black, uint64_t white) {
+        int best = 0;
+        uint64_t bestBlack = black, bestWhite = white;
+        for(int sym = 1; sym < Count; ++sym) {
+            uint64_t b = transform(black, sym);
+            uint64_t w = transform(white, sym);
+            if(b < bestBlack || (b == bestBlack && w < bestWhite)) {
+                best = sym;
+                bestBlack = b;
+                bestWhite = w;
+            }
+        }
+        return best;
+    }
+
+    // Zobrist key of a position given as bitboards, independent of the
+    // incrementally maintained board key
+    inline uint64_t hashBitboards(uint64_t black, uint64_t white, int player) {
+        uint64_t key = Zobrist::sideToMove[player - 1];
+        for(uint64_t bits = black; bits; bits &= bits - 1)
+            key ^= Zobrist::squarePiece[Bitboard::bitToSquare(__builtin_ctzll(bits))][1];
+        for(uint64_t bits = white; bits; bits &= bits - 1)
+            key ^= Zobrist::squarePiece[Bitboard::bitToSquare(__builtin_ctzll(bits))][2];
+        return key;
+    }
+
+    // Symmetry-invariant key; sym receives the orientation used so moves can
+    // be mapped with transformSquare/inverseSquare
+    inline uint64_t canonicalKey(uint64_t black, uint64_t white, int player, int& sym) {
+        sym = canonical(black, white);
+        return hashBitboards(transform(black, sym), transform(white, sym), player);
+    }
+
+    // square mapped into the canonical orientation sym. A symmetric position
+    // has several canonical orientations; the smallest resulting square is
+    // used so equivalent moves share one representative.
+    inline int canonicalSquare(uint64_t black, uint64_t white, int sym, int square) {
+        uint64_t canonicalBlack = transform(black, sym), canonicalWhite = transform(white, sym);
+        int best = transformSquare(square, sym);
+        for(int other = 0; other < Count; ++other) {
+            if(transform(black, other) == canonicalBlack && transform(white, other) == canonicalWhite)
+                best = std::min(best, transformSquare(square, other));
+        }
+        return best;
+    }
+}
+
+// Helper function to count flips for move ordering
+int countFlipsForMove(const class OthelloBoard& board, int move, int player);
+
+class OthelloBoard {
+public:
+    static const int EMPTY = 0;
+    static const int BLACK = 1;
+    static const int WHITE = 2;
+    static const int OUTER = 3;
+    static const int AllDirections[8];
+    static const int weights[100];
+    int board[100];
+    uint64_t zobristKey; // Incremental Zobrist hash
+    const Nnue::Network* network;  // Optional evaluator; accumulator follows every move while set
+    Nnue::Accumulator accumulator;
+
+    OthelloBoard() : network(nullptr) { 
+        Zobrist::init();
+        initBoard(); 
+    }
+
+    void initBoard() {
+        zobristKey = 0;
+        for(int i = 0; i < 100; i++) {
+            if(i < 10 || i >= 90 || i%10 == 0 || i%10 == 9) {
+                board[i] = OUTER;
+            } else {
+                board[i] = EMPTY;
+            }
+            zobristKey ^= Zobrist::squarePiece[i][board[i]];
+        }
+        
+        // Set starting position
+        zobristKey ^= Zobrist::squarePiece[44][EMPTY]; board[44] = BLACK; zobristKey ^= Zobrist::squarePiece[44][BLACK];
+        zobristKey ^= Zobrist::squarePiece[45][EMPTY]; board[45] = WHITE; zobristKey ^= Zobrist::squarePiece[45][WHITE];
+        zobristKey ^= Zobrist::squarePiece[54][EMPTY]; board[54] = WHITE; zobristKey ^= Zobrist::squarePiece[54][WHITE];
+        zobristKey ^= Zobrist::squarePiece[55][EMPTY]; board[55] = BLACK; zobristKey ^= Zobrist::squarePiece[55][BLACK];
+        
+        // Start with BLACK to move
+        zobristKey ^= Zobrist::sideToMove[BLACK - 1];
+        refreshAccumulator();
+    }
+
+    // Load a position from bitboards, rebuilding the Zobrist key from scratch.
+    // The key follows the move-built convention (see getZobristKey), so the
+    // side to move is not part of the board; pass it to getZobristKey.
+    void setPosition(uint64_t black, uint64_t white) {
+        zobristKey = 0;
+        for(int i = 0; i < 100; i++) {
+            if(i < 10 || i >= 90 || i%10 == 0 || i%10 == 9) {
+                board[i] = OUTER;
+            } else {
+                uint64_t bit = 1ULL << Bitboard::squareToBit(i);
+                board[i] = (black & bit) ? BLACK : (white & bit) ? WHITE : EMPTY;
+            }
+            zobristKey ^= Zobrist::squarePiece[i][board[i]];
+        }
+        zobristKey ^= Zobrist::sideToMove[parityMover(black | white) - 1];
+        refreshAccumulator();
+    }
+
+    // Attach (or with nullptr detach) a neural evaluator; the accumulator is
+    // rebuilt from the current discs and then updated by make/unmake
+    void setNetwork(const Nnue::Network* net) {
+        network = net;
+        refreshAccumulator();
+    }
+
+    void refreshAccumulator() {
+        if(network) accumulator.refresh(*network, bitboard(BLACK), bitboard(WHITE));
+    }
+
+    int opponent(int player) const {
+        return (player == BLACK) ? WHITE : BLACK;
+    }
+
+    bool legalMove(int move, int player) const {
+        if(board[move] != EMPTY) return false;
+        for(int d = 0; d < 8; ++d) {
+            int dir = AllDirections[d];
+            int pos = move + dir;
+            if(board[pos] != opponent(player)) continue;
+            while(true) {
+                pos += dir;
+                if(board[pos] == player) return true;
+                if(board[pos] == EMPTY || board[pos] == OUTER) break;
+            }
+        }
+        return false;
+    }
+
+    bool hasLegalMoves(int player) const {
+        for(int i = 11; i <= 88; ++i) {
+            if(i % 10 == 0 || i % 10 == 9) { 
+                i += (i % 10 == 9); // Skip border fast
+                continue; 
+            }
+            if(board[i] == EMPTY && legalMove(i, player)) return true;
+        }
+        return false;
+    }
+
+    int findBracketingPiece(int square, int player, int dir) const {
+        if(board[square] == player) return square;
+        if(board[square] == opponent(player))
+            return findBracketingPiece(square + dir, player, dir);
+        return 0;
+    }
+
+    // A move flips at most 6 discs along each of the 4 lines through it
+    static const int MaxFlips = 24;
+
+    // Store flipped positions for undo (fixed size so make/unmake never allocate)
+    struct UndoInfo {
+        int move;
+        int flipCount;
+        int flippedPositions[MaxFlips];
+    };
+
+    void makeFlipsAndRecord(int move, int player, int dir, UndoInfo& undo) {
+        int bracketer = findBracketingPiece(move + dir, player, dir);
+        if(bracketer) {
+            for(int pos = move + dir; pos != bracketer; pos += dir) {
+                undo.flippedPositions[undo.flipCount++] = pos;
+                // Update Zobrist key for the flip
+                zobristKey ^= Zobrist::squarePiece[pos][board[pos]]; // Remove old piece
+                board[pos] = player;
+                zobristKey ^= Zobrist::squarePiece[pos][player];     // Add new piece
+            }
+        }
+    }
+
+    void makeMoveWithUndo(int move, int player, UndoInfo& undo) {
+        undo.move = move;
+        undo.flipCount = 0;
+        
+        // Update Zobrist key for placing the piece
+        zobristKey ^= Zobrist::squarePiece[move][EMPTY];
+        board[move] = player;
+        zobristKey ^= Zobrist::squarePiece[move][player];
+        
+        for(int d = 0; d < 8; ++d)
+            makeFlipsAndRecord(move, player, AllDirections[d], undo);
+        
+        // Toggle side to move in hash
+        zobristKey ^= Zobrist::sideToMove[player - 1];
+        zobristKey ^= Zobrist::sideToMove[opponent(player) - 1];
+
+        if(network) {
+            accumulator.addDisc(*network, Bitboard::squareToBit(move), player - 1);
+            for(int i = 0; i < undo.flipCount; ++i)
+                accumulator.flipDisc(*network, Bitboard::squareToBit(undo.flippedPositions[i]), player - 1);
+        }
+    }
+
+    UndoInfo makeMoveWithUndo(int move, int player) {
+        UndoInfo undo;
+        makeMoveWithUndo(move, player, undo);
+        return undo;
+    }
+
+    // Plays a move for good; the Zobrist key stays in sync so keyed caches
+    // that outlive one search (the engine's eval cache) remain valid
+    void makeMove(int move, int player) {
+        UndoInfo undo;
+        makeMoveWithUndo(move, player, undo);
+    }
+
+    void unmakeMove(const UndoInfo& undo, int player) {
+        // Undo Zobrist key changes (reverse order of makeMoveWithUndo)
+        // Toggle side to move back
+        zobristKey ^= Zobrist::sideToMove[opponent(player) - 1];
+        zobristKey ^= Zobrist::sideToMove[player - 1];
+        
+        // Undo flipped pieces
+        int opponent_player = opponent(player);
+        for(int i = 0; i < undo.flipCount; ++i) {
+            int pos = undo.flippedPositions[i];
+            zobristKey ^= Zobrist::squarePiece[pos][player];         // Remove current piece
+            board[pos] = opponent_player;
+            zobristKey ^= Zobrist::squarePiece[pos][opponent_player]; // Restore original piece
+        }
+        
+        // Undo the move itself
+        zobristKey ^= Zobrist::squarePiece[undo.move][player];
+        board[undo.move] = EMPTY;
+        zobristKey ^= Zobrist::squarePiece[undo.move][EMPTY];
+
+        if(network) {
+            for(int i = 0; i < undo.flipCount; ++i)
+                accumulator.flipDisc(*network, Bitboard::squareToBit(undo.flippedPositions[i]), opponent_player - 1);
+            accumulator.removeDisc(*network, Bitboard::squareToBit(undo.move), player - 1);
+        }
+    }
+    
+    // Side that moves next if nobody has passed: every move adds one disc,
+    // so BLACK on an even disc count and WHITE on an odd one
+    static int parityMover(uint64_t discs) {
+        return (Bitboard::popcount(discs) & 1) ? WHITE : BLACK;
+    }
+
+    // Get Zobrist key for current position with player to move.
+    // Invariant: zobristKey holds the discs plus sideToMove[parityMover - 1].
+    // initBoard starts with BLACK on 4 discs, each make/unmake toggles both
+    // side terms along with one disc, and setPosition rebuilds the same
+    // thing, so the result depends only on the discs and player, never on
+    // how the board was loaded or whether a side passed.
+    uint64_t getZobristKey(int player) const {
+        return zobristKey ^ Zobrist::sideToMove[player - 1];
+    }
+
+    // 8x8 bitboard of the given player's discs
+    uint64_t bitboard(int player) const {
+        uint64_t bits = 0;
+        for(int bit = 0; bit < 64; ++bit) {
+            if(board[Bitboard::bitToSquare(bit)] == player) bits |= 1ULL << bit;
+        }
+        return bits;
+    }
+
+    // Key shared by all 8 symmetric variants of this position
+    uint64_t getCanonicalKey(int player, int& sym) const {
+        return Symmetry::canonicalKey(bitboard(BLACK), bitboard(WHITE), player, sym);
+    }
+
+    // Helper methods for advanced evaluation
+    int countPieces() const {
+        int count = 0;
+        for(int i = 11; i <= 88; i++) {
+            if(i % 10 != 0 && i % 10 != 9) { // Skip border
+                if(board[i] == BLACK || board[i] == WHITE) count++;
+            }
+        }
+        return count;
+    }
+    
+    int countDiscs(int player) const {
+        int count = 0;
+        for(int i = 11; i <= 88; i++) {
+            if(i % 10 != 0 && i % 10 != 9) { // Skip border
+                if(board[i] == player) count++;
+            }
+        }
+        return count;
+    }
+    
+    int mobility(int player) const {
+        int playerMoves = 0, opponentMoves = 0;
+        for(int move = 11; move <= 88; move++) {
+            if(move % 10 != 0 && move % 10 != 9) { // Skip border
+                if(legalMove(move, player)) playerMoves++;
+                if(legalMove(move, opponent(player))) opponentMoves++;
+            }
+        }
+        return (playerMoves - opponentMoves) * 10;
+    }
+    
+    int cornerControl(int player) const {
+        int corners[] = {11, 18, 81, 88}; // Corner positions
+        int score = 0;
+        for(int corner : corners) {
+            if(board[corner] == player) score += 100;
+            else if(board[corner] == opponent(player)) score -= 100;
+        }
+        return score;
+    }
+    
+    int edgeControl(int player) const {
+        // Edge positions (excluding corners and X-squares)
+        int edgePositions[] = {12,13,14,15,16,17, 21,31,41,51,61,71, 28,38,48,58,68,78, 82,83,84,85,86,87};
+        int score = 0;
+        for(int pos : edgePositions) {
+            if(board[pos] == player) score += 5;
+            else if(board[pos] == opponent(player)) score -= 5;
+        }
+        return score;
+    }
+    
+    bool isStableInDirection(int pos, int player, int dir) const {
+        // Check if piece is stable in one direction (either blocked by edge or friendly pieces)
+        int next = pos + dir;
+        while(board[next] == player) {
+            next += dir;
+        }
+        return (board[next] == OUTER); // Reached edge
+    }
+    
+    bool isStable(int pos, int player) const {
+        if(board[pos] != player) return false;
+        
+        // Corner pieces are always stable
+        if(pos == 11 || pos == 18 || pos == 81 || pos == 88) return true;
+        
+        // Check if stable in at least one direction pair
+        bool horizontalStable = isStableInDirection(pos, player, -1) || isStableInDirection(pos, player, 1);
+        bool verticalStable = isStableInDirection(pos, player, -10) || isStableInDirection(pos, player, 10);
+        bool diagonal1Stable = isStableInDirection(pos, player, -11) || isStableInDirection(pos, player, 11);
+        bool diagonal2Stable = isStableInDirection(pos, player, -9) || isStableInDirection(pos, player, 9);
+        
+        return horizontalStable && verticalStable && diagonal1Stable && diagonal2Stable;
+    }
+    
+    int stability(int player) const {
+        int stable = 0;
+        for(int pos = 11; pos <= 88; pos++) {
+            if(pos % 10 != 0 && pos % 10 != 9) { // Skip border
+                if(board[pos] == player && isStable(pos, player)) {
+                    stable += 10; // Stable pieces are valuable
+                } else if(board[pos] == opponent(player) && isStable(pos, opponent(player))) {
+                    stable -= 10;
+                }
+            }
+        }
+        return stable;
+    }
+    
+    int dangerousSquares(int player) const {
+        // X-squares adjacent to corners - only penalize if corner isn't controlled
+        const struct { int xSquare; int corner; } dangerousSpots[] = {
+            {22, 11}, {12, 11}, {21, 11},  // Corner 11 (top-left)
+            {27, 18}, {17, 18}, {28, 18},  // Corner 18 (top-right)
+            {72, 81}, {82, 81}, {71, 81},  // Corner 81 (bottom-left)
+            {77, 88}, {87, 88}, {78, 88}   // Corner 88 (bottom-right)
+        };
+        
+        int penalty = 0;
+        for(const auto& spot : dangerousSpots) {
+            // Only penalize X-squares if we don't control the adjacent corner
+            if(board[spot.corner] != player) {
+                if(board[spot.xSquare] == player) penalty -= 25;
+                else if(board[spot.xSquare] == opponent(player)) penalty += 25;
+            }
+        }
+        return penalty;
+    }
+    
+    int parity(int player) const {
+        int emptySquares = 64 - countPieces(); // 64 squares on board
+        // In endgame, having the last move can be advantageous
+        return (emptySquares % 2 == 1) ? 3 : -3; // Odd means we move last
+    }
+    
+    // Neural evaluation from the incrementally updated accumulator
+    int nnueEvaluation(int player) const {
+        return network->evaluate(accumulator.values[player - 1], accumulator.values[2 - player]);
+    }
+
+    // The attached network if any, otherwise the handcrafted evaluation
+    int staticEvaluation(int player) const {
+        return network ? nnueEvaluation(player) : advancedEvaluation(player);
+    }
+
+    int advancedEvaluation(int player) const {
+        int totalPieces = countPieces();
+        
+        int mobilityScore = mobility(player);
+        int cornerScore = cornerControl(player);
+        int edgeScore = edgeControl(player);
+        int stabilityScore = stability(player);
+        int dangerScore = dangerousSquares(player);
+        int parityScore = parity(player);
+        
+        // Weight factors based on game phase
+        if(totalPieces <= 20) {
+            // Opening: Prioritize mobility, avoid dangerous squares
+            return mobilityScore * 4 + cornerScore * 3 + dangerScore * 2;
+        } else if(totalPieces <= 50) {
+            // Midgame: Balanced approach
+            return mobilityScore * 2 + stabilityScore + cornerScore * 2 + 
+                   edgeScore + dangerScore;
+        } else {
+            // Endgame: Focus on disc count, corners, and parity
+            int discDiff = (countDiscs(player) - countDiscs(opponent(player)));
+            return discDiff * 3 + cornerScore * 3 + stabilityScore + parityScore;
+        }
+    }
+};
+
+// Compact 16-byte position record: black and white disc masks with the side
+// to move stored in the white mask's D4 bit. D4 is a starting square and can
+// never be empty, so its owner is recoverable from the black mask alone.
+struct PackedBoard {
+    static const uint64_t SideBit = 1ULL << 27; // D4 (square 44)
+
+    uint64_t black;
+    uint64_t white;
+
+    static PackedBoard fromBitboards(uint64_t black, uint64_t white, int player) {
+        PackedBoard packed;
+        packed.black = black;
+        packed.white = (white & ~SideBit) | (player == OthelloBoard::WHITE ? SideBit : 0);
+        return packed;
+    }
+
+    static PackedBoard pack(const OthelloBoard& board, int player) {
+        return fromBitboards(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE), player);
+    }
+
+    uint64_t blackDiscs() const {
+        return black;
+    }
+
+    uint64_t whiteDiscs() const {
+        return (white & ~SideBit) | (~black & SideBit);
+    }
+
+    int sideToMove() const {
+        return (white & SideBit) ? OthelloBoard::WHITE : OthelloBoard::BLACK;
+    }
+
+    void unpack(OthelloBoard& board, int& player) const {
+        player = sideToMove();
+        board.setPosition(blackDiscs(), whiteDiscs());
+    }
+
+    // Representative of this position's symmetry class
+    PackedBoard canonical() const {
+        uint64_t b = blackDiscs(), w = whiteDiscs();
+        int sym = Symmetry::canonical(b, w);
+        return fromBitboards(Symmetry::transform(b, sym), Symmetry::transform(w, sym), sideToMove());
+    }
+
+    bool operator==(const PackedBoard& other) const {
+        return black == other.black && white == other.white;
+    }
+
+    bool operator!=(const PackedBoard& other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const PackedBoard& other) const {
+        return black < other.black || (black == other.black && white < other.white);
+    }
+};
+
+static_assert(sizeof(PackedBoard) == 16, "PackedBoard must stay 16 bytes");
+
+#endif // OTHELLO_BOARD_H
@@ -0,0 +1,105 @@
+#include "othello_capi.h"
+#include "othello_engine.h"
+#include "parallel_solver.h"
+
+struct othello_engine {
+    OthelloEngine engine;
+};
+
+othello_engine* othello_engine_new(void) {
+    return new othello_engine();
+}
+
+void othello_engine_free(othello_engine* engine) {
+    delete engine;
+}
+
+void othello_set_board(othello_engine* engine, const int* cells) {
+    uint64_t black = 0, white = 0;
+    for(int bit = 0; bit < 64; ++bit) {
+        int cell = cells[Bitboard::bitToSquare(bit)];
+        if(cell == OthelloBoard::BLACK) black |= 1ULL << bit;
+        else if(cell == OthelloBoard::WHITE) white |= 1ULL << bit;
+    }
+    engine->engine.board.setPosition(black, white);
+}
+
+void othello_get_board(const othello_engine* engine, int* cells) {
+    for(int i = 0; i < 100; ++i) cells[i] = engine->engine.board.board[i];
+}
+
+int othello_legal_moves(const othello_engine* engine, int player, int* moves, int capacity) {
+    const OthelloBoard& board = engine->engine.board;
+    int count = 0;
+    for(int i = 11; i <= 88; ++i) {
+        if(board.legalMove(i, player)) {
+            if(count < capacity) moves[count] = i;
+            count++;
+        }
+    }
+    return count;
+}
+
+int othello_make_move(othello_engine* engine, int move, int player) {
+    OthelloBoard& board = engine->engine.board;
+    if(move < 11 || move > 88 || !board.legalMove(move, player)) return -1;
+    return (int)board.makeMoveWithUndo(move, player).flipCount;
+}
+
+int othello_evaluate(const othello_engine* engine, int player) {
+    return engine->engine.board.staticEvaluation(player);
+}
+
+int othello_load_network(othello_engine* engine, const char* path) {
+    if(!path) {
+        engine->engine.setNetwork(nullptr);
+        return 0;
+    }
+    return engine->engine.loadNetwork(path) ? 0 : -1;
+}
+
+int othello_search(othello_engine* engine, int player, int max_depth, int time_ms) {
+    OthelloEngine& search = engine->engine;
+    if(!search.board.hasLegalMoves(player)) return -1;
+    search.timeManager.enableTimeLimit(time_ms > 0);
+    if(time_ms > 0) search.timeManager.setTimeLimit(time_ms);
+    int move = search.chooseMove(player, max_depth < 1 ? 1 : max_depth);
+    if(move == -1) {
+        // Time ran out before depth 1 finished: fall back to the first legal move
+        for(int i = 11; i <= 88 && move == -1; ++i) {
+            if(search.board.legalMove(i, player)) move = i;
+        }
+    }
+    return move;
+}
+
+int othello_analyze(othello_engine* engine, int player, int max_depth, int time_ms, int num_pv,
+                    othello_line* lines, int capacity) {
+    OthelloEngine& search = engine->engine;
+    search.timeManager.enableTimeLimit(time_ms > 0);
+    if(time_ms > 0) search.timeManager.setTimeLimit(time_ms);
+    std::vector<RootLine> result = search.analyze(player, max_depth < 1 ? 1 : max_depth, num_pv < 1 ? 1 : num_pv);
+    for(int i = 0; i < (int)result.size() && i < capacity; ++i) {
+        const RootLine& line = result[i];
+        lines[i].move = line.move;
+        lines[i].score = line.score;
+        lines[i].bound = line.bound;
+        lines[i].pv_length = std::min((int)line.pv.size(), OTHELLO_MAX_PV);
+        std::copy(line.pv.begin(), line.pv.begin() + lines[i].pv_length, lines[i].pv);
+    }
+    return (int)result.size();
+}
+
+void othello_set_limits(othello_engine* engine, unsigned long long max_nodes, int max_depth) {
+    engine->engine.timeManager.setNodeLimit(max_nodes);
+    engine->engine.timeManager.setDepthLimit(max_depth);
+}
+
+void othello_set_wld_empties(othello_engine* engine, int empties) {
+    engine->engine.wldEmpties = empties;
+}
+
+void othello_set_solver_threads(othello_engine* engine, int threads) {
+    if(threads == 1) engine->engine.endgameSolver.reset();
+    else engine->engine.endgameSolver = std::make_shared<ParallelSolver>(threads);
+}
@@ -0,0 +1,74 @@
+#ifndef OTHELLO_CAPI_H
+#define OTHELLO_CAPI_H
+
+// C interface to the engine, exported from libothello.so.
+// Boards are 100-cell 10x10 mailbox arrays (row*10 + col, rows/cols 1-8)
+// using the OthelloBoard encoding: 0 empty, 1 black, 2 white, 3 border.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct othello_engine othello_engine;
+
+othello_engine* othello_engine_new(void);
+void othello_engine_free(othello_engine* engine);
+
+void othello_set_board(othello_engine* engine, const int* cells);
+void othello_get_board(const othello_engine* engine, int* cells);
+
+// Fills moves with up to capacity legal squares; returns the number of legal moves
+int othello_legal_moves(const othello_engine* engine, int player, int* moves, int capacity);
+
+// Plays a move; returns the number of flipped discs, or -1 if the move is illegal
+int othello_make_move(othello_engine* engine, int move, int player);
+
+// Static evaluation from player's point of view (the network if one is loaded)
+int othello_evaluate(const othello_engine* engine, int player);
+
+// Loads a neural network weight file (see nnue.h) and uses it for evaluation
+// and search; path NULL returns to the built-in evaluation. Returns 0, or -1
+// if the file can't be loaded (the current evaluator is kept).
+int othello_load_network(othello_engine* engine, const char* path);
+
+// Iterative deepening search limited by depth and time (time_ms <= 0: no
+// time limit). With few enough empties a win/loss/draw solve is tried first.
+// Returns the best move, or -1 if player has no legal move.
+int othello_search(othello_engine* engine, int player, int max_depth, int time_ms);
+
+// Multi-PV analysis result for one root move. Bounds match the engine's TT
+// flags: the best num_pv moves are exact, the others upper bounds.
+enum { OTHELLO_BOUND_EXACT = 0, OTHELLO_BOUND_LOWER = 1, OTHELLO_BOUND_UPPER = 2 };
+#define OTHELLO_MAX_PV 60
+typedef struct othello_line {
+    int move;
+    int score;
+    int bound;
+    int pv_length;            // Principal variation, starting with move
+    int pv[OTHELLO_MAX_PV];
+} othello_line;
+
+// Multi-PV analysis limited by depth and time (time_ms <= 0: no time limit):
+// exact scores and PVs for the best num_pv root moves, upper bounds for the
+// rest, best first, from the last completed depth. Fills up to capacity
+// lines and returns the number of root moves (0 if player can't move).
+int othello_analyze(othello_engine* engine, int player, int max_depth, int time_ms, int num_pv,
+                    othello_line* lines, int capacity);
+
+// Node and depth budgets for othello_search and othello_analyze (0:
+// unlimited). With a node budget and no time limit, searches are
+// reproducible on any machine.
+void othello_set_limits(othello_engine* engine, unsigned long long max_nodes, int max_depth);
+
+// Empties at or below which othello_search tries a win/loss/draw solve (0: never)
+void othello_set_wld_empties(othello_engine* engine, int empties);
+
+// Threads for endgame solves: 1 is the serial solver, more split the tree
+// over a thread pool, 0 uses every core
+void othello_set_solver_threads(othello_engine* engine, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OTHELLO_CAPI_H
@@ -0,0 +1,654 @@
+// Self-tests for invariants the search relies on but can't verify itself:
+// packed positions round-trip, Zobrist keys don't depend on how a board was
+// loaded, symmetric positions share canonical keys and moves, cached
+// evaluations belong to the right side, multi-PV bounds are consistent, the
+// search drivers agree, node budgets are deterministic and respected, WLD
+// solves agree with exact ones, sessions size their tables as configured,
+// WTHOR imports match a direct replay, and the faster and parallel paths agree
+// with their reference implementations.
+// Every check walks the positions of seeded random games (passes included)
+// and counts mismatches; the exit status is 1 if any check fails ("make check").
+#include "opening_index.h"
+#include "othello_engine.h"
+#include "parallel_solver.h"
+#include "session.h"
+#include "wthor.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    struct Options {
+        int games = 200;
+        unsigned seed = 20240601;
+        const char* filter = nullptr;
+    };
+
+    struct Outcome {
+        uint64_t cases;
+        uint64_t failures;
+        std::string firstFailure;
+
+        Outcome() : cases(0), failures(0) {}
+
+        void expect(bool ok, const std::string& what) {
+            cases++;
+            if(ok) return;
+            if(!failures) firstFailure = what;
+            failures++;
+        }
+    };
+
+    // Calls visit with every position of games random games, board reached
+    // by play. After a pass it is called again for the other side, so
+    // positions whose side to move isn't the disc-parity side are covered.
+    void forEachPosition(const Options& options, const std::function<void(OthelloBoard&, int)>& visit) {
+        std::mt19937 rng(options.seed);
+        for(int game = 0; game < options.games; ++game) {
+            OthelloBoard board;
+            int player = OthelloBoard::BLACK;
+            for(;;) {
+                std::vector<int> moves;
+                for(int i = 11; i <= 88; ++i) {
+                    if(board.legalMove(i, player)) moves.push_back(i);
+                }
+                visit(board, player);
+                if(moves.empty()) {
+                    if(!board.hasLegalMoves(board.opponent(player))) break;
+                    player = board.opponent(player);
+                    continue;
+                }
+                board.makeMoveWithUndo(moves[rng() % moves.size()], player);
+                player = board.opponent(player);
+            }
+        }
+    }
+
+    std::string describe(const OthelloBoard& board, int player) {
+        char text[80];
+        snprintf(text, sizeof(text), "black %016llx white %016llx, %s to move",
+                 (unsigned long long)board.bitboard(OthelloBoard::BLACK),
+                 (unsigned long long)board.bitboard(OthelloBoard::WHITE),
+                 player == OthelloBoard::BLACK ? "black" : "white");
+        return text;
+    }
+
+    // PackedBoard keeps discs and side to move through pack/unpack, and its
+    // canonical form is a fixed point
+    Outcome checkPacked(const Options& options) {
+        Outcome outcome;
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            PackedBoard packed = PackedBoard::pack(board, player);
+            OthelloBoard unpacked;
+            int unpackedPlayer;
+            packed.unpack(unpacked, unpackedPlayer);
+            bool same = unpackedPlayer == player;
+            for(int i = 0; i < 100; ++i) same = same && unpacked.board[i] == board.board[i];
+            outcome.expect(same, describe(board, player));
+            outcome.expect(packed.canonical().canonical() == packed.canonical(), describe(board, player));
+        });
+        return outcome;
+    }
+
+    // A board loaded with setPosition hashes like the same board reached by
+    // play, for either side to move, and the two sides get different keys
+    Outcome checkZobrist(const Options& options) {
+        Outcome outcome;
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            OthelloBoard loaded;
+            loaded.setPosition(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+            int opponent = board.opponent(player);
+            outcome.expect(loaded.getZobristKey(player) == board.getZobristKey(player) &&
+                           loaded.getZobristKey(opponent) == board.getZobristKey(opponent) &&
+                           board.getZobristKey(player) != board.getZobristKey(opponent), describe(board, player));
+        });
+        return outcome;
+    }
+
+    // Symmetry-canonical TT keys: all 8 orientations of a position get the
+    // same canonicalKey; transformSquare and inverseSquare round-trip and
+    // agree with transform; and a best move stored in canonical orientation
+    // (as alphabeta stores it) maps back to a legal move in every orientation
+    Outcome checkSymmetry(const Options& options) {
+        Outcome outcome;
+        for(int sym = 0; sym < Symmetry::Count; ++sym) {
+            for(int square = 11; square <= 88; ++square) {
+                if(square % 10 == 0 || square % 10 == 9) continue;
+                int mapped = Symmetry::transformSquare(square, sym);
+                outcome.expect(Symmetry::inverseSquare(mapped, sym) == square &&
+                               Symmetry::transform(1ULL << Bitboard::squareToBit(square), sym) ==
+                               1ULL << Bitboard::squareToBit(mapped), "square " + std::to_string(square));
+            }
+        }
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            uint64_t black = board.bitboard(OthelloBoard::BLACK), white = board.bitboard(OthelloBoard::WHITE);
+            int sym;
+            uint64_t key = Symmetry::canonicalKey(black, white, player, sym);
+            std::vector<int> stored;
+            for(int move = 11; move <= 88; ++move) {
+                if(board.legalMove(move, player)) stored.push_back(Symmetry::transformSquare(move, sym));
+            }
+            for(int other = 0; other < Symmetry::Count; ++other) {
+                uint64_t b = Symmetry::transform(black, other), w = Symmetry::transform(white, other);
+                int otherSym;
+                bool ok = Symmetry::canonicalKey(b, w, player, otherSym) == key;
+                uint64_t legal = player == OthelloBoard::BLACK ? Bitboard::legalMoves(b, w) : Bitboard::legalMoves(w, b);
+                for(int move : stored) {
+                    int back = Symmetry::inverseSquare(move, otherSym);
+                    ok = ok && (legal >> Bitboard::squareToBit(back) & 1);
+                }
+                outcome.expect(ok, describe(board, player) + ", orientation " + std::to_string(other));
+            }
+        });
+        return outcome;
+    }
+
+    // Network with small random weights, so sums stay far from overflow
+    // and every layer contributes
+    std::shared_ptr<Nnue::Network> randomNetwork(unsigned seed) {
+        std::shared_ptr<Nnue::Network> network(new Nnue::Network());
+        std::mt19937 rng(seed);
+        auto next = [&rng](int range) { return (int)(rng() % (2 * range + 1)) - range; };
+        for(int i = 0; i < Nnue::Hidden; ++i) network->featureBias[i] = (int16_t)next(32);
+        for(int f = 0; f < Nnue::Features; ++f)
+            for(int i = 0; i < Nnue::Hidden; ++i) network->featureWeights[f][i] = (int16_t)next(16);
+        for(int i = 0; i < Nnue::L1; ++i) {
+            network->l1Bias[i] = next(256);
+            for(int j = 0; j < 2 * Nnue::Hidden; ++j) network->l1Weights[i][j] = (int8_t)next(32);
+        }
+        for(int i = 0; i < Nnue::L2; ++i) {
+            network->l2Bias[i] = next(256);
+            for(int j = 0; j < Nnue::L1; ++j) network->l2Weights[i][j] = (int8_t)next(32);
+        }
+        network->outputBias = next(256);
+        for(int i = 0; i < Nnue::L2; ++i) network->outputWeights[i] = (int8_t)next(32);
+        return network;
+    }
+
+    // The eval cache, kept across loads, never answers for the other side:
+    // each position is loaded and evaluated for the opponent, then loaded
+    // again and evaluated for the side to move. The cache only serves
+    // network evaluations, so a random network is attached. A disabled cache
+    // and key 0 (an empty slot's key) never hit.
+    Outcome checkEvalCache(const Options& options) {
+        Outcome outcome;
+        EvalCache cache;
+        int value;
+        cache.store(1, 5);
+        outcome.expect(!cache.probe(1, value), "disabled cache hit");
+        cache.enable(true);
+        cache.store(0, 5);
+        outcome.expect(!cache.probe(0, value), "key 0 hit");
+        OthelloEngine engine;
+        engine.setNetwork(randomNetwork(options.seed));
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            uint64_t black = board.bitboard(OthelloBoard::BLACK), white = board.bitboard(OthelloBoard::WHITE);
+            for(int side : {board.opponent(player), player}) {
+                engine.board.setPosition(black, white);
+                outcome.expect(engine.evaluate(side) == engine.board.staticEvaluation(side), describe(board, side));
+            }
+        });
+        return outcome;
+    }
+
+    // Multi-PV analysis reports exactly min(numPV, moves) exact lines, all
+    // ranked above the bounded ones. Every 8th position, depth 3, numPV 1..3.
+    Outcome checkMultiPv(const Options& options) {
+        Outcome outcome;
+        OthelloEngine engine;
+        engine.timeManager.enableTimeLimit(false);
+        int visited = 0;
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            if(visited++ % 8 || !board.hasLegalMoves(player)) return;
+            engine.board.setPosition(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+            for(int numPV = 1; numPV <= 3; ++numPV) {
+                std::vector<RootLine> lines = engine.analyze(player, 3, numPV);
+                int exact = 0;
+                bool ranked = true;
+                for(size_t i = 0; i < lines.size(); ++i) {
+                    if(lines[i].bound != TTEntry::EXACT) continue;
+                    ranked = ranked && (int)i == exact;
+                    exact++;
+                }
+                outcome.expect(ranked && exact == std::min(numPV, (int)lines.size()), describe(board, player));
+            }
+        });
+        return outcome;
+    }
+
+    // MTD(f) and aspiration windows converge on the same fixed-depth score
+    // from a cleared TT, starting from a guess of 0. Late move reductions and
+    // multi-cut only prune zero-window nodes, so they see different trees
+    // under the two drivers and are switched off. Every 8th position, depth 4.
+    Outcome checkDrivers(const Options& options) {
+        Outcome outcome;
+        OthelloEngine engine;
+        engine.timeManager.enableTimeLimit(false);
+        engine.selective = false;
+        int visited = 0;
+        forEachPosition(options, [&](OthelloBoard& board, int player) {
+            if(visited++ % 8 || !board.hasLegalMoves(player)) return;
+            engine.board.setPosition(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+            int scores[2];
+            for(int driver = 0; driver < 2; ++driver) {
+                engine.stats = SearchStats();
+                engine.timeExpired = false;
+                engine.resetSearchStack();
+                engine.transTable.clear();
+                engine.timeManager.startTimer();
+                int move;
+                scores[driver] = driver ? engine.mtdf(player, 4, 0, move) : engine.aspirationSearch(player, 4, 0, move);
+            }
+            outcome.expect(scores[0] == scores[1], describe(board, player) + ", aspiration " +
+                           std::to_string(scores[0]) + ", mtdf " + std::to_string(scores[1]));
+        });
+        return outcome;
+    }
+
+    bool sameAccumulator(const OthelloBoard& board, const Nnue::Network& network) {
+        Nnue::Accumulator fresh;
+        fresh.refresh(network, board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+        return memcmp(fresh.values, board.accumulator.values, sizeof(fresh.values)) == 0;
+    }
+
+    // The incrementally updated accumulator equals a full refresh after
+    // every legal move and again after its unmake
+    Outcome checkAccumulator(const Options& options) {
+        Outcome outcome;
+        std::shared_ptr<Nnue::Network> network = randomNetwork(options.seed);
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            OthelloBoard board = played;
+            board.setNetwork(network.get());
+            OthelloBoard::UndoInfo undo;
+            for(int move = 11; move <= 88; ++move) {
+                if(!board.legalMove(move, player)) continue;
+                board.makeMoveWithUndo(move, player, undo);
+                outcome.expect(sameAccumulator(board, *network), describe(played, player) + ", after a move");
+                board.unmakeMove(undo, player);
+                outcome.expect(sameAccumulator(board, *network), describe(played, player) + ", after an unmake");
+            }
+        });
+        return outcome;
+    }
+
+    // The AVX2 dense layers (when the CPU has them) match the scalar ones
+    Outcome checkNnueKernels(const Options& options) {
+        Outcome outcome;
+        std::shared_ptr<Nnue::Network> network = randomNetwork(options.seed);
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            Nnue::Accumulator accumulator;
+            accumulator.refresh(*network, played.bitboard(OthelloBoard::BLACK), played.bitboard(OthelloBoard::WHITE));
+            const int16_t* own = accumulator.values[player - 1];
+            const int16_t* other = accumulator.values[2 - player];
+            outcome.expect(network->evaluate(own, other) == network->evaluateScalar(own, other), describe(played, player));
+        });
+        return outcome;
+    }
+
+    // LeafBatch scores equal advancedEvaluation for every child of every
+    // position, both in a batch (the AVX2 kernel where available) and singly
+    Outcome checkLeafBatch(const Options& options) {
+        Outcome outcome;
+        LeafBatch batch;
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            OthelloBoard board = played;
+            uint64_t P = board.bitboard(player), O = board.bitboard(board.opponent(player));
+            std::vector<int> expected;
+            batch.clear();
+            OthelloBoard::UndoInfo undo;
+            for(int move = 11; move <= 88; ++move) {
+                if(!board.legalMove(move, player)) continue;
+                int bit = Bitboard::squareToBit(move);
+                uint64_t flipped = Bitboard::flips(P, O, bit);
+                batch.add(O & ~flipped, P | flipped | (1ULL << bit));
+                board.makeMoveWithUndo(move, player, undo);
+                expected.push_back(board.advancedEvaluation(board.opponent(player)));
+                board.unmakeMove(undo, player);
+            }
+            batch.evaluate();
+            for(int i = 0; i < batch.count; ++i) {
+                outcome.expect(batch.score[i] == expected[i] &&
+                               LeafBatch::evaluate(batch.player[i], batch.opponent[i]) == expected[i],
+                               describe(played, player) + ", a child");
+            }
+            outcome.expect(LeafBatch::evaluate(P, O) == board.advancedEvaluation(player), describe(played, player));
+        });
+        return outcome;
+    }
+
+    // chooseMove under a node budget picks the same move with the same node
+    // count in two fresh engines, and the WLD solve plus any fallback search
+    // stays within budget + MinSearchNodes. Every 8th position at 14 to 22
+    // empties, so both sides of wldEmpties and the fallback after a lost or
+    // unfinished solve are covered.
+    Outcome checkNodeBudget(const Options& options) {
+        Outcome outcome;
+        int visited = 0, fallbacks = 0;
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            int empties = 64 - played.countPieces();
+            if(empties < 14 || empties > 22 || visited++ % 8 || !played.hasLegalMoves(player)) return;
+            for(uint64_t limit : {2000, 20000}) {
+                int moves[2];
+                uint64_t nodes[2];
+                for(int run = 0; run < 2; ++run) {
+                    OthelloEngine engine;
+                    engine.transTable.setCapacity(1 << 16); // Clearing the default table would dominate
+                    engine.timeManager.enableTimeLimit(false);
+                    engine.timeManager.setNodeLimit(limit);
+                    engine.board.setPosition(played.bitboard(OthelloBoard::BLACK), played.bitboard(OthelloBoard::WHITE));
+                    moves[run] = engine.chooseMove(player, MaxSearchDepth);
+                    nodes[run] = engine.stats.total();
+                    if(run == 0 && empties <= engine.wldEmpties && engine.stats.nodes) fallbacks++;
+                }
+                outcome.expect(moves[0] == moves[1] && nodes[0] == nodes[1] && played.legalMove(moves[0], player) &&
+                               nodes[0] <= limit + MinSearchNodes,
+                               describe(played, player) + ", limit " + std::to_string(limit) +
+                               ", nodes " + std::to_string(nodes[0]) + "/" + std::to_string(nodes[1]));
+            }
+        });
+        outcome.expect(fallbacks > 0, "no solve fell back to the heuristic search");
+        return outcome;
+    }
+
+    // The WLD solve has the sign of the exact score, and playing its move
+    // keeps that result under an exact solve of the child. Every 4th
+    // position at 12 to 14 empties.
+    Outcome checkWldSolve(const Options& options) {
+        Outcome outcome;
+        OthelloEngine engine;
+        engine.timeManager.enableTimeLimit(false);
+        int visited = 0;
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            int empties = 64 - played.countPieces();
+            if(empties < 12 || empties > 14 || visited++ % 4) return;
+            engine.board.setPosition(played.bitboard(OthelloBoard::BLACK), played.bitboard(OthelloBoard::WHITE));
+            SolveResult exact = engine.solve(player, false);
+            SolveResult wld = engine.solve(player, true);
+            int sign = (exact.score > 0) - (exact.score < 0);
+            bool ok = exact.complete && wld.complete && wld.score == sign;
+            if(ok && played.hasLegalMoves(player)) {
+                ok = played.legalMove(wld.move, player);
+                if(ok) {
+                    engine.board.makeMove(wld.move, player);
+                    int child = -engine.solve(engine.board.opponent(player), false).score;
+                    ok = (child > 0) - (child < 0) == sign;
+                }
+            }
+            outcome.expect(ok, describe(played, player) + ", exact " + std::to_string(exact.score) +
+                           ", wld " + std::to_string(wld.score));
+        });
+        return outcome;
+    }
+
+    // ParallelSolver (4 threads, so splits happen even on one core) gives
+    // the serial solver's exact and WLD scores, and its move achieves the
+    // score. Positions at 14 empties from every 8th game.
+    Outcome checkParallelSolver(const Options& options) {
+        Outcome outcome;
+        std::shared_ptr<ParallelSolver> solver = std::make_shared<ParallelSolver>(4);
+        int visited = 0;
+        forEachPosition(options, [&](OthelloBoard& played, int player) {
+            if(64 - played.countPieces() != 14 || visited++ % 8 || !played.hasLegalMoves(player)) return;
+            for(int wld = 0; wld < 2; ++wld) {
+                OthelloEngine serial, parallel;
+                serial.timeManager.enableTimeLimit(false);
+                parallel.timeManager.enableTimeLimit(false);
+                parallel.endgameSolver = solver;
+                serial.board.setPosition(played.bitboard(OthelloBoard::BLACK), played.bitboard(OthelloBoard::WHITE));
+                parallel.board = serial.board;
+                SolveResult expected = serial.solve(player, wld);
+                SolveResult result = parallel.solve(player, wld);
+                bool ok = result.complete && result.score == expected.score && played.legalMove(result.move, player);
+                if(ok) {
+                    // The child after the chosen move has the negated score
+                    serial.board.makeMove(result.move, player);
+                    int opponent = serial.board.opponent(player);
+                    ok = -serial.solve(opponent, wld).score == result.score;
+                }
+                outcome.expect(ok, describe(played, player) + (wld ? ", wld" : ", exact"));
+            }
+        });
+        return outcome;
+    }
+
+    // A session's transposition table follows SessionOptions::ttMegabytes:
+    // the largest power of two of 16-byte entries that fits, and the engine
+    // default for 0
+    Outcome checkSessionTable(const Options&) {
+        Outcome outcome;
+        for(size_t megabytes : {0, 1, 3, 16, 100}) {
+            SessionOptions sessionOptions;
+            sessionOptions.ttMegabytes = megabytes;
+            Session session(1, sessionOptions, nullptr);
+            size_t expected = size_t(1) << DefaultTTBits;
+            if(megabytes) {
+                for(expected = 1; expected * 2 * TTBytesPerEntry <= megabytes << 20; expected *= 2) {}
+            }
+            outcome.expect(session.tableEntries() == expected, std::to_string(megabytes) + " MB: " +
+                           std::to_string(session.tableEntries()) + " entries");
+        }
+        return outcome;
+    }
+
+    typedef std::map<std::pair<uint64_t, int>, std::pair<uint32_t, uint32_t> > OpeningCounts;
+
+    // Appends a random game from the standard start position to a WTHOR
+    // database image, played on OthelloBoard rather than through Wthor, and
+    // adds each position and next move to counts as the index should.
+    // Returns true if someone had to pass.
+    bool addRandomGame(std::mt19937& rng, std::vector<unsigned char>& image, OpeningCounts& counts) {
+        uint64_t discs[3];
+        Wthor::startPosition(discs);
+        OthelloBoard board;
+        board.setPosition(discs[OthelloBoard::BLACK], discs[OthelloBoard::WHITE]);
+        std::vector<std::pair<uint64_t, int> > visits;
+        std::vector<int> movers;
+        unsigned char record[Wthor::GameSize] = {};
+        int player = OthelloBoard::BLACK, plies = 0;
+        bool passed = false;
+        for(;;) {
+            std::vector<int> moves;
+            for(int i = 11; i <= 88; ++i) {
+                if(board.legalMove(i, player)) moves.push_back(i);
+            }
+            uint64_t black = board.bitboard(OthelloBoard::BLACK), white = board.bitboard(OthelloBoard::WHITE);
+            int sym;
+            uint64_t key = Symmetry::canonicalKey(black, white, player, sym);
+            if(moves.empty()) {
+                if(!board.hasLegalMoves(board.opponent(player))) {
+                    visits.push_back(std::make_pair(key, 0));
+                    movers.push_back(player);
+                    break;
+                }
+                player = board.opponent(player);
+                passed = true;
+                continue;
+            }
+            int move = moves[rng() % moves.size()];
+            visits.push_back(std::make_pair(key, Symmetry::canonicalSquare(black, white, sym, move)));
+            movers.push_back(player);
+            record[Wthor::MovesOffset + plies++] = (unsigned char)move;
+            board.makeMove(move, player);
+            player = board.opponent(player);
+        }
+        int blackDiscs = Bitboard::popcount(board.bitboard(OthelloBoard::BLACK));
+        record[6] = record[7] = (unsigned char)blackDiscs;
+        image.insert(image.end(), record, record + Wthor::GameSize);
+
+        int blackPoints = blackDiscs > 32 ? 2 : blackDiscs == 32 ? 1 : 0;
+        for(size_t i = 0; i < visits.size(); ++i) {
+            uint32_t points = movers[i] == OthelloBoard::BLACK ? blackPoints : 2 - blackPoints;
+            std::pair<uint32_t, uint32_t>& total = counts[std::make_pair(visits[i].first, 0)];
+            total.first++;
+            total.second += points;
+            if(visits[i].second) {
+                std::pair<uint32_t, uint32_t>& next = counts[visits[i]];
+                next.first++;
+                next.second += points;
+            }
+        }
+        return passed;
+    }
+
+    bool readFile(const std::string& path, std::vector<unsigned char>& bytes) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if(!file) return false;
+        unsigned char buffer[4096];
+        size_t got;
+        while((got = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + got);
+        fclose(file);
+        return true;
+    }
+
+    // WTHOR import on a synthetic database of random games (some with
+    // passes) and two corrupt records: the index is byte-identical at 1 and
+    // 4 threads, the corrupt games are rejected, and every position's game
+    // and move counts match a direct replay of the games.
+    Outcome checkWthorImport(const Options& options) {
+        Outcome outcome;
+        std::mt19937 rng(options.seed);
+        std::vector<unsigned char> image(Wthor::HeaderSize, 0);
+        image[12] = 8;
+        OpeningCounts counts;
+        int games = 12 * options.games, passes = 0;
+        for(int game = 0; game < games; ++game) {
+            passes += addRandomGame(rng, image, counts);
+            if(game == games / 2) {
+                // Copies of this game with an illegal move (an occupied
+                // square) and with a malformed square
+                std::vector<unsigned char> record(image.end() - Wthor::GameSize, image.end());
+                record[Wthor::MovesOffset + 10] = record[Wthor::MovesOffset + 2];
+                image.insert(image.end(), record.begin(), record.end());
+                record[Wthor::MovesOffset + 10] = 99;
+                image.insert(image.end(), record.begin(), record.end());
+            }
+        }
+        uint32_t records = games + 2;
+        for(int i = 0; i < 4; ++i) image[4 + i] = (unsigned char)(records >> (8 * i));
+        outcome.expect(passes > 0, "no synthetic game has a pass");
+
+        char dir[] = "/tmp/othello_check.XXXXXX";
+        if(!mkdtemp(dir)) {
+            outcome.expect(false, "cannot create a temporary directory");
+            return outcome;
+        }
+        std::string database = std::string(dir) + "/games.wtb";
+        std::string indexes[2] = {std::string(dir) + "/serial.idx", std::string(dir) + "/parallel.idx"};
+        FILE* file = fopen(database.c_str(), "wb");
+        bool written = file && fwrite(image.data(), 1, image.size(), file) == image.size();
+        if(file && fclose(file) != 0) written = false;
+        outcome.expect(written, "cannot write " + database);
+
+        WthorFile wthor;
+        if(written && wthor.open(database.c_str())) {
+            std::vector<const WthorFile*> files(1, &wthor);
+            std::vector<unsigned char> bytes[2];
+            for(int run = 0; run < 2; ++run) {
+                ImportStats stats;
+                std::vector<OpeningRecord> imported = importGames(files, run ? 4 : 1, Wthor::MaxMoves, stats);
+                outcome.expect(stats.games == (uint64_t)games && stats.badGames == 2,
+                               std::to_string(stats.games) + " games imported, " +
+                               std::to_string(stats.badGames) + " rejected");
+                outcome.expect(writeOpeningIndex(indexes[run].c_str(), imported) && readFile(indexes[run], bytes[run]),
+                               "cannot write and read back " + indexes[run]);
+            }
+            outcome.expect(bytes[0] == bytes[1], "index differs between 1 and 4 threads");
+
+            OpeningIndex index;
+            if(index.open(indexes[1].c_str())) {
+                outcome.expect(index.size() == counts.size(), std::to_string(index.size()) + " index records, " +
+                               std::to_string(counts.size()) + " expected");
+                for(OpeningCounts::const_iterator it = counts.begin(); it != counts.end(); ++it) {
+                    if(it->first.second != 0) continue;
+                    std::vector<OpeningRecord> found;
+                    bool ok = index.lookup(it->first.first, found);
+                    for(const OpeningRecord& record : found) {
+                        OpeningCounts::const_iterator expected = counts.find(std::make_pair(record.key, record.move));
+                        ok = ok && expected != counts.end() && expected->second.first == record.games &&
+                             expected->second.second == record.points;
+                    }
+                    char key[40];
+                    snprintf(key, sizeof(key), "key %016llx", (unsigned long long)it->first.first);
+                    outcome.expect(ok, key);
+                }
+            } else {
+                outcome.expect(false, "cannot open " + indexes[1]);
+            }
+        } else {
+            outcome.expect(false, "cannot open " + database);
+        }
+        wthor.close();
+        remove(database.c_str());
+        for(const std::string& path : indexes) remove(path.c_str());
+        rmdir(dir);
+        return outcome;
+    }
+
+    struct Check {
+        const char* name;
+        std::function<Outcome(const Options&)> run;
+    };
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_check [options]\n"
+            "  -n GAMES   random games per check (default 200)\n"
+            "  -s SEED    random seed (default 20240601)\n"
+            "  -f NAME    only checks whose name contains NAME\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int opt;
+    while((opt = getopt(argc, argv, "n:s:f:h")) != -1) {
+        switch(opt) {
+            case 'n': options.games = std::max(1, atoi(optarg)); break;
+            case 's': options.seed = (unsigned)strtoul(optarg, nullptr, 10); break;
+            case 'f': options.filter = optarg; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(optind < argc) {
+        usage();
+        return 1;
+    }
+
+    Zobrist::init();
+    std::vector<Check> checks = {
+        {"packed", checkPacked},
+        {"zobrist", checkZobrist},
+        {"symmetry", checkSymmetry},
+        {"evalcache", checkEvalCache},
+        {"multipv", checkMultiPv},
+        {"drivers", checkDrivers},
+        {"nnue-acc", checkAccumulator},
+        {"nnue-simd", checkNnueKernels},
+        {"batch", checkLeafBatch},
+        {"budget", checkNodeBudget},
+        {"wld", checkWldSolve},
+        {"parallel", checkParallelSolver},
+        {"session", checkSessionTable},
+        {"wthor", checkWthorImport},
+    };
+    int failed = 0;
+    for(const Check& check : checks) {
+        if(options.filter && !strstr(check.name, options.filter)) continue;
+        Outcome outcome = check.run(options);
+        printf("%-12s %10llu cases  ", check.name, (unsigned long long)outcome.cases);
+        if(outcome.failures) {
+            printf("FAILED %llu, first: %s\n", (unsigned long long)outcome.failures, outcome.firstFailure.c_str());
+            failed++;
+        } else {
+            printf("ok\n");
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,1146 @@
+#ifndef OTHELLO_ENGINE_H
+#define OTHELLO_ENGINE_H
+
+#include "othello_board.h"
+#include "leaf_batch.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <atomic>
+
+const int WinningValue = 32767;
+const int LosingValue = -32767;
+const int nply = 5;
+const int CanonicalHashPlies = 2; // Plies from the root probed with symmetry-canonical keys
+const int DefaultWldEmpties = 18;  // Switch to a win/loss/draw solve at this many empties
+const int MinSearchMs = 200;       // Heuristic search time left after a failed solve
+const uint64_t MinSearchNodes = 1000; // Heuristic search nodes left after a failed solve
+const int SolveTTMinEmpties = 7;   // Endgame nodes with fewer empties skip the TT
+const int SolveOrderMinEmpties = 6; // Fastest-first move ordering above this many empties
+const int QuiescenceDepth = 4;     // Max plies of quiescence below the horizon
+const int MaxSearchDepth = 60;     // Deepest nominal search; no game has more moves left
+const int MaxSearchPly = MaxSearchDepth + QuiescenceDepth + 1; // Heights used by alphabeta + quiescence
+const int MaxMoves = 64;           // Upper bound on legal moves in any position
+const uint64_t TimeCheckInterval = 1024; // Nodes between clock reads (power of two)
+const int DefaultEvalCacheBits = 16; // 2^16 eval cache slots (1 MB)
+const uint64_t SolveKeySalt[2] = {0x5d1f0a3c2b4e6978ULL, 0x3a7c9e1d5b2f4086ULL}; // [exact, WLD] TT key spaces
+
+// Transposition table entry
+struct TTEntry {
+    int value;
+    int depth;
+    int bestMove;
+    enum Flag { EXACT, LOWER_BOUND, UPPER_BOUND } flag;
+    
+    TTEntry() : value(0), depth(0), bestMove(-1), flag(EXACT) {}
+    TTEntry(int v, int d, int move, Flag f) : value(v), depth(d), bestMove(move), flag(f) {}
+
+    // Bound type of a fail-soft result searched with window (alpha, beta)
+    static Flag boundFor(int value, int alpha, int beta) {
+        if(value <= alpha) return UPPER_BOUND;
+        if(value >= beta) return LOWER_BOUND;
+        return EXACT;
+    }
+};
+
+const int DefaultTTBits = 20; // 2^20 TT entries (16 MB)
+
+// Transposition table: a fixed array of 2^bits entries in two-entry buckets.
+// It is allocated by the first clear(), which every search starts with, and
+// then reused, so stores never allocate. clear() starts a new generation
+// instead of wiping the array; entries from older generations read as empty.
+class TranspositionTable {
+private:
+    struct Slot {
+        uint64_t key;
+        int32_t value;
+        int8_t depth;      // Depths and empties are at most 60
+        int8_t bestMove;   // Mailbox square or -1
+        uint8_t flag;
+        uint8_t generation;
+    };
+    std::vector<Slot> slots;
+    uint64_t mask;        // Index mask of the first slot of a bucket
+    int bits;
+    uint8_t generation;
+
+    void allocate() {
+        std::vector<Slot>(size_t(1) << bits, Slot()).swap(slots); // Generation 0: all empty
+        mask = (slots.size() - 1) & ~uint64_t(1);
+        generation = 0;
+    }
+
+    bool live(const Slot& slot) const {
+        return slot.generation == generation;
+    }
+
+public:
+    explicit TranspositionTable(int tableBits = DefaultTTBits) : mask(0), bits(tableBits), generation(0) {}
+
+    // Resize to the largest power of two not above entries (at least one
+    // bucket); drops all entries and frees the old array until the next clear()
+    void setCapacity(size_t entries) {
+        bits = 1;
+        while(bits < 40 && (size_t(2) << bits) <= entries) bits++;
+        std::vector<Slot>().swap(slots);
+    }
+
+    void store(uint64_t zobristKey, int value, int depth, int bestMove, TTEntry::Flag flag) {
+        if(slots.empty()) return;
+        Slot* bucket = &slots[zobristKey & mask];
+        Slot* target = nullptr;
+        for(int i = 0; i < 2; ++i) {
+            if(live(bucket[i]) && bucket[i].key == zobristKey) {
+                // Only replace if deeper or equal depth (depth-preferred replacement)
+                if(depth < bucket[i].depth) return;
+                target = &bucket[i];
+                break;
+            }
+        }
+        if(!target) {
+            // Another position: take a stale slot, otherwise the shallower one
+            if(!live(bucket[0])) target = &bucket[0];
+            else if(!live(bucket[1])) target = &bucket[1];
+            else target = bucket[1].depth < bucket[0].depth ? &bucket[1] : &bucket[0];
+        }
+        target->key = zobristKey;
+        target->value = value;
+        target->depth = (int8_t)depth;
+        target->bestMove = (int8_t)bestMove;
+        target->flag = (uint8_t)flag;
+        target->generation = generation;
+    }
+    
+    bool lookup(uint64_t zobristKey, int depth, int alpha, int beta, int& value, int& bestMove) const {
+        TTEntry entry;
+        if(!probe(zobristKey, entry)) return false;
+        if(entry.depth < depth) return false;
+        
+        bestMove = entry.bestMove;
+        
+        switch(entry.flag) {
+            case TTEntry::EXACT:
+                value = entry.value;
+                return true;
+            case TTEntry::LOWER_BOUND:
+                if(entry.value >= beta) {
+                    value = entry.value;
+                    return true;
+                }
+                break;
+            case TTEntry::UPPER_BOUND:
+                if(entry.value <= alpha) {
+                    value = entry.value;
+                    return true;
+                }
+                break;
+        }
+        return false;
+    }
+
+    // Raw entry access regardless of depth and bounds (PV extraction)
+    bool probe(uint64_t zobristKey, TTEntry& entry) const {
+        if(slots.empty()) return false;
+        const Slot* bucket = &slots[zobristKey & mask];
+        for(int i = 0; i < 2; ++i) {
+            if(live(bucket[i]) && bucket[i].key == zobristKey) {
+                entry = TTEntry(bucket[i].value, bucket[i].depth, bucket[i].bestMove, (TTEntry::Flag)bucket[i].flag);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Empty the table: allocate it the first time, otherwise start a new
+    // generation (wiping the array only when the counter wraps)
+    void clear() {
+        if(slots.empty()) allocate();
+        if(++generation == 0) {
+            for(Slot& slot : slots) slot.generation = 0;
+            generation = 1;
+        }
+    }
+    
+    // Entries the table holds when allocated
+    size_t size() const {
+        return size_t(1) << bits;
+    }
+};
+
+const size_t TTBytesPerEntry = 16; // sizeof a TranspositionTable slot, for sizing by memory
+
+// Direct-mapped cache of static evaluations keyed by getZobristKey(player).
+// Each key maps to one slot and a newer position simply overwrites it, so
+// probes cost one load and the size stays fixed regardless of the TT. The
+// key depends only on the discs and the side to move (see getZobristKey),
+// so entries stay valid across setPosition, passes and new games.
+// The engine only uses it with a network attached (see
+// OthelloEngine::evaluate); until then no slots are allocated.
+class EvalCache {
+private:
+    struct Entry {
+        uint64_t key;
+        int value;
+    };
+    std::vector<Entry> entries;
+    uint64_t mask;
+    int bits;
+
+    void allocate() {
+        std::vector<Entry>(size_t(1) << bits, Entry()).swap(entries); // Releases a larger old table
+        mask = entries.size() - 1;
+    }
+
+public:
+    explicit EvalCache(int cacheBits = DefaultEvalCacheBits) : mask(0), bits(cacheBits) {}
+
+    // 2^bits slots once enabled; drops all cached values
+    void resize(int cacheBits) {
+        bits = cacheBits;
+        if(enabled()) allocate();
+    }
+
+    // Allocate the slots, or release them
+    void enable(bool on) {
+        if(!on) std::vector<Entry>().swap(entries);
+        else if(!enabled()) allocate();
+    }
+
+    bool enabled() const {
+        return !entries.empty();
+    }
+
+    // Misses while disabled. Key 0 also always misses: it is what an empty
+    // slot holds, so a hit on it could be a slot nothing was stored in.
+    bool probe(uint64_t key, int& value) const {
+        if(!enabled() || key == 0) return false;
+        const Entry& entry = entries[key & mask];
+        if(entry.key != key) return false;
+        value = entry.value;
+        return true;
+    }
+
+    // Ignored while disabled, and for key 0 (see probe)
+    void store(uint64_t key, int value) {
+        if(!enabled() || key == 0) return;
+        Entry& entry = entries[key & mask];
+        entry.key = key;
+        entry.value = value;
+    }
+
+    // Empty every slot (key 0)
+    void clear() {
+        for(Entry& entry : entries) {
+            entry.key = 0;
+            entry.value = 0;
+        }
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+};
+
+// Search budgets: a wall-clock limit plus optional node and depth limits.
+// Node and depth budgets make a search reproducible on any machine.
+class TimeManager {
+private:
+    std::chrono::time_point<std::chrono::steady_clock> startTime;
+    std::chrono::milliseconds timeLimit;
+    bool timeLimitEnabled;
+    uint64_t nodeLimit; // 0 = unlimited
+    int depthLimit;     // 0 = unlimited
+    const std::atomic<bool>* stopFlag; // Set by another thread to cancel the search
+    
+public:
+    TimeManager() : timeLimit(2000), timeLimitEnabled(true), nodeLimit(0), depthLimit(0),
+                    stopFlag(nullptr) {} // Default 2 seconds
+    
+    void startTimer() {
+        startTime = std::chrono::steady_clock::now();
+    }
+    
+    void setTimeLimit(int milliseconds) {
+        timeLimit = std::chrono::milliseconds(milliseconds);
+    }
+    
+    void enableTimeLimit(bool enable) {
+        timeLimitEnabled = enable;
+    }
+    
+    bool timeUp() const {
+        if (!timeLimitEnabled) return false;
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
+        return elapsed >= timeLimit;
+    }
+    
+    void setNodeLimit(uint64_t nodes) {
+        nodeLimit = nodes;
+    }
+
+    uint64_t getNodeLimit() const {
+        return nodeLimit;
+    }
+
+    void setDepthLimit(int depth) {
+        depthLimit = depth;
+    }
+
+    // maxDepth capped by the depth budget
+    int limitDepth(int maxDepth) const {
+        return depthLimit > 0 ? std::min(maxDepth, depthLimit) : maxDepth;
+    }
+
+    // Watch flag (owned by the caller) for cancellation; nullptr to stop watching
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+
+    bool stopRequested() const {
+        return stopFlag && stopFlag->load(std::memory_order_relaxed);
+    }
+
+    // Cheap per-node stop test: nodes is the search's running node count.
+    // The node budget is exact; the clock and the stop flag are read every
+    // TimeCheckInterval nodes.
+    bool budgetExhausted(uint64_t nodes) const {
+        if(nodeLimit && nodes >= nodeLimit) return true;
+        return (nodes & (TimeCheckInterval - 1)) == 0 && (stopRequested() || timeUp());
+    }
+    
+    int getElapsedMs() const {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
+        return elapsed.count();
+    }
+    
+    int getTimeLimitMs() const {
+        return (int)timeLimit.count();
+    }
+    
+    int getRemainingMs() const {
+        if (!timeLimitEnabled) return INT_MAX;
+        return std::max(0, (int)(timeLimit.count() - getElapsedMs()));
+    }
+};
+
+// Result for one root move in multi-PV analysis
+struct RootLine {
+    int move;
+    int score;
+    TTEntry::Flag bound;   // EXACT for the reported lines, UPPER_BOUND for moves proven below them
+    std::vector<int> pv;   // Starts with move
+};
+
+// Counters for the most recent search
+struct SearchStats {
+    uint64_t nodes;   // alphabeta calls
+    uint64_t qnodes;  // quiescenceSearch calls
+    uint64_t solveNodes; // solveEndgame calls
+    uint64_t evalProbes; // evaluate calls
+    uint64_t evalHits;   // evaluate calls answered by the eval cache
+
+    SearchStats() : nodes(0), qnodes(0), solveNodes(0), evalProbes(0), evalHits(0) {}
+
+    // Nodes counted against TimeManager's node budget
+    uint64_t total() const {
+        return nodes + qnodes + solveNodes;
+    }
+
+    double evalHitRate() const {
+        return evalProbes ? (double)evalHits / evalProbes : 0.0;
+    }
+};
+
+// Search state for one height from the root. The engine keeps a contiguous
+// stack of these so move lists, ordering scores, undo records, killers and
+// the triangular PV are reused instead of allocated per node.
+struct SearchPly {
+    int moves[MaxMoves];
+    int64_t scores[MaxMoves];    // Ordering keys, parallel to moves
+    int moveCount;
+    OthelloBoard::UndoInfo undo;
+    int killers[2];              // Quiet moves that caused cutoffs at this height
+    int pv[MaxSearchPly];        // Principal variation from this height
+    int pvLength;
+    int childEvals[MaxMoves];    // Batched static evals of the children, parallel to moves
+    int standPat;                // Static eval batched by the parent, or NoStandPat
+};
+
+const int NoStandPat = INT_MIN;
+
+// Result of an endgame solve from the root
+struct SolveResult {
+    int score;      // WLD: 1 win, 0 draw, -1 loss; exact: final disc difference
+    int move;       // Proving move (mailbox square), -1 if there is none
+    bool complete;  // False if the time limit stopped the solve
+};
+
+// Replacement for the serial endgame solve (see ParallelSolver): solves P
+// to move against O, exactly or win/loss/draw with the same windows and
+// scores as OthelloEngine::solve, within budget, and leaves its node count
+// in stats.solveNodes.
+class EndgameSolver {
+public:
+    virtual ~EndgameSolver() {}
+    virtual SolveResult solve(uint64_t P, uint64_t O, bool wld, const TimeManager& budget, SearchStats& stats) = 0;
+};
+
+// SDL-free search: board, transposition table, time control and the
+// alpha-beta / iterative deepening driver used by the game and the library
+class OthelloEngine {
+public:
+    // Root driver used by iterativeDeepening for each depth
+    enum SearchDriver { ASPIRATION, MTDF };
+
+    OthelloBoard board;
+    TranspositionTable transTable;
+    EvalCache evalCache; // Network evals only; kept across searches since evals don't depend on depth or window
+    TimeManager timeManager;
+    bool timeExpired; // Set when the time or node budget runs out
+    int historyHeuristic[100]; // History heuristic for move ordering
+    SearchDriver driver;
+    SearchStats stats;
+    int wldEmpties; // chooseMove solves win/loss/draw at or below this many empties
+    std::vector<SearchPly> searchStack; // Indexed by height; sized once so the search never allocates
+    std::shared_ptr<const Nnue::Network> network; // Optional neural evaluator, shareable between engines
+    LeafBatch leafBatch; // Scratch for evaluateChildren
+    std::shared_ptr<EndgameSolver> endgameSolver; // Optional, e.g. parallel; solve() delegates to it
+    uint64_t excludedRootMoves; // Bitboard of root moves alphabeta skips (multi-PV the naive way)
+    bool selective; // Late move reductions and multi-cut; off, the search is plain alpha-beta
+
+    OthelloEngine() : timeExpired(false), driver(ASPIRATION), wldEmpties(DefaultWldEmpties),
+                      searchStack(MaxSearchPly + 1), excludedRootMoves(0), selective(true) {
+        // Set AI thinking time based on game phase
+        timeManager.setTimeLimit(2000); // 2 seconds per move
+        // Initialize history heuristic
+        for(int i = 0; i < 100; ++i) historyHeuristic[i] = 0;
+        resetSearchStack();
+    }
+
+    // TT key for the current position. Near the root, where symmetric
+    // transpositions are common, positions are keyed by symmetry class and
+    // sym receives the orientation that TT moves are stored in.
+    uint64_t positionKey(int player, int height, int& sym) const {
+        sym = 0;
+        if(height > CanonicalHashPlies) return board.getZobristKey(player);
+        return board.getCanonicalKey(player, sym);
+    }
+
+    // Use net for static evaluation (nullptr: back to advancedEvaluation)
+    void setNetwork(std::shared_ptr<const Nnue::Network> net) {
+        network = net;
+        board.setNetwork(network.get());
+        evalCache.enable(network != nullptr);
+        evalCache.clear(); // Cached values came from the previous evaluator
+    }
+
+    // Load and use a weight file; on failure the current evaluator is kept
+    bool loadNetwork(const char* path) {
+        std::shared_ptr<Nnue::Network> net(new Nnue::Network());
+        if(!net->load(path)) return false;
+        setNetwork(net);
+        return true;
+    }
+
+    // Static evaluation, through the eval cache only with a network. The
+    // handcrafted evaluation gets nearly all its stand pats from the batched
+    // evaluateChildren, which never probes the cache, and the few scalar
+    // calls left cost less than keeping the cache filled would.
+    int evaluate(int player) {
+        if(!network) return board.advancedEvaluation(player);
+        stats.evalProbes++;
+        uint64_t key = board.getZobristKey(player);
+        int value;
+        if(evalCache.probe(key, value)) {
+            stats.evalHits++;
+            return value;
+        }
+        value = board.staticEvaluation(player);
+        evalCache.store(key, value);
+        return value;
+    }
+
+    // Children that enter quiescence (from depth-1 and quiescence nodes)
+    // start with a stand pat, the static eval of the child position. Score
+    // them all at once into frame.childEvals, in frame order; the search
+    // hands each to its child through SearchPly::standPat. Children beyond a
+    // cutoff are scored needlessly, but a batched bitboard eval costs a
+    // small fraction of a scalar one.
+    void evaluateChildren(int player, SearchPly& frame) {
+        uint64_t P = board.bitboard(player), O = board.bitboard(board.opponent(player));
+        leafBatch.clear();
+        for(int index = 0; index < frame.moveCount; ++index) {
+            int bit = Bitboard::squareToBit(frame.moves[index]);
+            uint64_t flipped = Bitboard::flips(P, O, bit);
+            leafBatch.add(O & ~flipped, P | flipped | (1ULL << bit)); // Opponent to move
+        }
+        leafBatch.evaluate();
+        std::copy(leafBatch.score, leafBatch.score + frame.moveCount, frame.childEvals);
+    }
+
+    static bool isCorner(int square) {
+        return square == 11 || square == 18 || square == 81 || square == 88;
+    }
+
+    // Ordering key: TT move → corners → killers → history → flips → static
+    // weights, packed so one integer compare ranks moves
+    static int64_t orderKey(bool ttMove, bool corner, bool killer, int history, int flips, int weight) {
+        return ((int64_t)ttMove << 62) | ((int64_t)corner << 61) | ((int64_t)killer << 60) |
+               ((int64_t)history << 16) | (flips << 8) | (weight + 128);
+    }
+
+    static int orderFlips(int64_t key) {
+        return (int)(key >> 8) & 0xff;
+    }
+
+    // Descending insertion sort of frame.moves by frame.scores (move lists are short)
+    static void sortMoves(SearchPly& frame) {
+        for(int i = 1; i < frame.moveCount; ++i) {
+            int move = frame.moves[i];
+            int64_t score = frame.scores[i];
+            int j = i;
+            for(; j > 0 && frame.scores[j-1] < score; --j) {
+                frame.moves[j] = frame.moves[j-1];
+                frame.scores[j] = frame.scores[j-1];
+            }
+            frame.moves[j] = move;
+            frame.scores[j] = score;
+        }
+    }
+
+    // PV at height becomes move followed by the child's PV
+    void updatePV(int height, int move) {
+        SearchPly& frame = searchStack[height];
+        const SearchPly& child = searchStack[height + 1];
+        frame.pv[0] = move;
+        std::copy(child.pv, child.pv + child.pvLength, frame.pv + 1);
+        frame.pvLength = child.pvLength + 1;
+    }
+
+    // Best root move of the last search, -1 if no move raised alpha
+    int rootMove() const {
+        return searchStack[0].pvLength > 0 ? searchStack[0].pv[0] : -1;
+    }
+
+    void resetSearchStack() {
+        for(SearchPly& frame : searchStack) {
+            frame.killers[0] = frame.killers[1] = -1;
+            frame.pvLength = 0;
+            frame.standPat = NoStandPat;
+        }
+    }
+
+    int alphabeta(int player, int alpha, int beta, int ply, int height = 0) {
+        stats.nodes++;
+        SearchPly& frame = searchStack[height];
+        frame.pvLength = 0;
+        // Check the time and node budgets
+        if(timeManager.budgetExhausted(stats.total())) {
+            timeExpired = true;
+            return alpha; // Return current lower bound to maintain consistency
+        }
+        
+        int originalAlpha = alpha;
+        int sym;
+        uint64_t zobristKey = positionKey(player, height, sym);
+        
+        // Check transposition table
+        int ttValue, ttMove = -1;
+        bool ttHit = transTable.lookup(zobristKey, ply, alpha, beta, ttValue, ttMove);
+        ttMove = Symmetry::inverseSquare(ttMove, sym);
+        if(ttHit) {
+            if(ply > 0 && ttMove != -1) {
+                frame.pv[0] = ttMove;
+                frame.pvLength = 1;
+            }
+            return ttValue;
+        }
+        
+        if(ply == 0) {
+            // Enter quiescence search to resolve tactical sequences
+            int qScore = quiescenceSearch(player, alpha, beta, QuiescenceDepth, height);
+            transTable.store(zobristKey, qScore, ply, -1, TTEntry::boundFor(qScore, originalAlpha, beta));
+            return qScore;
+        }
+        
+        // Fast move generation: only check inner 8x8 squares and empty cells.
+        // Each move is scored once; the TT move sorts first.
+        frame.moveCount = 0;
+        for(int i = 11; i <= 88; ++i) {
+            if(i % 10 == 0 || i % 10 == 9) { 
+                i += (i % 10 == 9); // Skip border fast: jump to next row
+                continue; 
+            }
+            if(board.board[i] == OthelloBoard::EMPTY && board.legalMove(i, player)) {
+                if(height == 0 && (excludedRootMoves >> Bitboard::squareToBit(i) & 1)) continue;
+                bool killer = (i == frame.killers[0] || i == frame.killers[1]);
+                frame.scores[frame.moveCount] = orderKey(i == ttMove, isCorner(i), killer, historyHeuristic[i],
+                                                         countFlipsForMove(board, i, player), OthelloBoard::weights[i]);
+                frame.moves[frame.moveCount++] = i;
+            }
+        }
+        sortMoves(frame);
+        
+        if(frame.moveCount == 0) {
+            if(board.hasLegalMoves(board.opponent(player))) {
+                int val = -alphabeta(board.opponent(player), -beta, -alpha, ply-1, height+1);
+                transTable.store(zobristKey, val, ply, -1, TTEntry::boundFor(val, originalAlpha, beta));
+                return val;
+            }
+            int diff = 0;
+            for(int i = 0; i < 100; ++i) diff += (board.board[i] == player) - (board.board[i] == board.opponent(player));
+            int val = (diff > 0) ? WinningValue : (diff < 0) ? LosingValue : 0;
+            transTable.store(zobristKey, val, ply, -1, TTEntry::EXACT);
+            return val;
+        }
+        
+        int bestVal = INT_MIN;
+        int bestMove = -1;
+        bool isPVNode = (beta - alpha > 1);
+        int cutoffCount = 0; // For multi-cut pruning
+        bool batched = (ply == 1 && !network); // The batch matches advancedEvaluation only
+        if(batched) evaluateChildren(player, frame);
+        SearchPly& child = searchStack[height + 1];
+        
+        for(int index = 0; index < frame.moveCount; ++index) {
+            // Check time limit during search
+            if(timeExpired) break;
+            
+            int move = frame.moves[index];
+            int moveCount = index + 1;
+            
+            // Determine if we should use Late Move Reductions (LMR)
+            bool isCornerMove = isCorner(move);
+            bool isHighFlipMove = orderFlips(frame.scores[index]) >= 6;
+            bool shouldReduce = selective && (moveCount > 3) && (ply >= 3) && !isPVNode && !isCornerMove && !isHighFlipMove;
+            
+            board.makeMoveWithUndo(move, player, frame.undo);
+            if(batched) child.standPat = frame.childEvals[index];
+            int val;
+            
+            if(moveCount == 1) {
+                // Search first move with full window (PV move)
+                val = -alphabeta(board.opponent(player), -beta, -alpha, ply-1, height+1);
+            } else {
+                int newDepth = ply - 1;
+                
+                // Late Move Reductions: reduce depth for later moves
+                if(shouldReduce) {
+                    newDepth = std::max(1, ply - 2); // Reduce by 1, but keep at least depth 1
+                }
+                
+                // Principal Variation Search (PVS): use null window for non-PV nodes
+                if(isPVNode) {
+                    // Try with null window first
+                    val = -alphabeta(board.opponent(player), -alpha-1, -alpha, newDepth, height+1);
+                    
+                    // If it beats alpha, re-search with full window at full depth
+                    if(val > alpha && val < beta && !timeExpired) {
+                        val = -alphabeta(board.opponent(player), -beta, -alpha, ply-1, height+1);
+                    }
+                } else {
+                    // Non-PV node: use null window
+                    val = -alphabeta(board.opponent(player), -alpha-1, -alpha, newDepth, height+1);
+                    
+                    // If reduced move beats alpha, re-search at full depth
+                    if(shouldReduce && val > alpha && !timeExpired) {
+                        val = -alphabeta(board.opponent(player), -alpha-1, -alpha, ply-1, height+1);
+                    }
+                }
+            }
+            
+            board.unmakeMove(frame.undo, player);
+            child.standPat = NoStandPat;
+            
+            if(timeExpired) break;
+            
+            if(val > bestVal) {
+                bestVal = val;
+                bestMove = move;
+                if(bestVal > alpha) {
+                    alpha = bestVal;
+                    updatePV(height, bestMove);
+                }
+                if(alpha >= beta) {
+                    // Update history heuristic and killers on cutoff
+                    historyHeuristic[bestMove] += ply * ply;
+                    if(!isCornerMove && frame.killers[0] != bestMove) {
+                        frame.killers[1] = frame.killers[0];
+                        frame.killers[0] = bestMove;
+                    }
+                    cutoffCount++;
+                    
+                    // Multi-cut pruning: if multiple moves cause cutoffs at reduced depth,
+                    // assume position is too good and prune immediately
+                    if(selective && !isPVNode && ply >= 3 && cutoffCount >= 2) {
+                        // Try a few more moves at reduced depth to verify the cutoff
+                        for(int next = index + 1; next < frame.moveCount && next <= index + 3; ++next) {
+                            if(timeExpired) break;
+                            
+                            board.makeMoveWithUndo(frame.moves[next], player, frame.undo);
+                            int verifyVal = -alphabeta(board.opponent(player), -beta, -alpha, 
+                                                     std::max(1, ply-3), height+1); // Reduced depth
+                            board.unmakeMove(frame.undo, player);
+                            
+                            if(verifyVal >= beta) {
+                                // Another cutoff - position is definitely too good
+                                return bestVal;
+                            }
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+        
+        // Store in transposition table
+        TTEntry::Flag flag = TTEntry::boundFor(bestVal, originalAlpha, beta);
+        transTable.store(zobristKey, bestVal, ply, Symmetry::transformSquare(bestMove, sym), flag);
+        
+        return bestVal;
+    }
+
+    int quiescenceSearch(int player, int alpha, int beta, int maxDepth, int height) {
+        stats.qnodes++;
+        SearchPly& frame = searchStack[height];
+        frame.pvLength = 0;
+        // Check the time and node budgets
+        if(timeManager.budgetExhausted(stats.total())) {
+            timeExpired = true;
+            return alpha;
+        }
+        
+        // Stand pat evaluation - assume we can do at least this well
+        int standPat = frame.standPat != NoStandPat ? frame.standPat : evaluate(player);
+        if(standPat >= beta) return standPat; // Fail soft: keep the real bound
+        if(standPat > alpha) alpha = standPat;
+        
+        // If we've reached max quiescence depth, return stand pat
+        if(maxDepth <= 0) return standPat;
+        
+        // Generate only "tactical" moves - high flip count, corners, edge captures
+        frame.moveCount = 0;
+        for(int i = 11; i <= 88; ++i) {
+            if(i % 10 == 0 || i % 10 == 9) { 
+                i += (i % 10 == 9);
+                continue; 
+            }
+            if(board.board[i] == OthelloBoard::EMPTY && board.legalMove(i, player)) {
+                // Only consider "tactical" moves in quiescence
+                bool corner = isCorner(i);
+                bool isEdge = (i >= 12 && i <= 17) || (i >= 21 && i <= 28 && (i%10==1 || i%10==8)) ||
+                             (i >= 71 && i <= 78 && (i%10==1 || i%10==8)) || (i >= 82 && i <= 87);
+                int flipCount = countFlipsForMove(board, i, player);
+                bool isHighFlip = flipCount >= 4; // High flip count moves
+                
+                if(corner || isEdge || isHighFlip) {
+                    // Corners first, then most flips
+                    frame.scores[frame.moveCount] = orderKey(false, corner, false, 0, flipCount, -128);
+                    frame.moves[frame.moveCount++] = i;
+                }
+            }
+        }
+        
+        // If no tactical moves, return stand pat
+        if(frame.moveCount == 0) return standPat;
+        sortMoves(frame);
+        
+        int bestVal = standPat;
+        bool batched = !network;
+        if(batched) evaluateChildren(player, frame);
+        SearchPly& child = searchStack[height + 1];
+        
+        for(int index = 0; index < frame.moveCount; ++index) {
+            if(timeExpired) break;
+            
+            int move = frame.moves[index];
+            board.makeMoveWithUndo(move, player, frame.undo);
+            if(batched) child.standPat = frame.childEvals[index];
+            int val = -quiescenceSearch(board.opponent(player), -beta, -alpha, maxDepth-1, height+1);
+            board.unmakeMove(frame.undo, player);
+            child.standPat = NoStandPat;
+            
+            if(timeExpired) break;
+            
+            if(val > bestVal) {
+                bestVal = val;
+                if(val > alpha) {
+                    alpha = val;
+                    if(alpha >= beta) break; // Beta cutoff
+                }
+            }
+        }
+        
+        return bestVal;
+    }
+
+    // Aspiration windows: search a window around the previous iteration's
+    // score and widen it (doubling) on fail-low or fail-high
+    int aspirationSearch(int player, int depth, int guess, int& move) {
+        int delta = 64; // window half-size
+        int alpha = guess - delta;
+        int beta = guess + delta;
+        int score;
+        
+        // Aspiration window loop
+        for(;;) {
+            score = alphabeta(player, alpha, beta, depth);
+            
+            if(timeExpired) break;
+            
+            // Check if we need to widen the window
+            if(score <= alpha) {
+                // Fail-low: widen down
+                alpha -= delta;
+                delta <<= 1; // Double window size
+                continue;
+            } else if(score >= beta) {
+                // Fail-high: widen up
+                beta += delta;
+                delta <<= 1; // Double window size
+                continue;
+            } else {
+                // Success: score is within window
+                break;
+            }
+        }
+        move = rootMove();
+        return score;
+    }
+
+    // MTD(f): converge on the score with zero-window searches starting from
+    // the previous iteration's score. Relies on the TT to make the repeated
+    // passes cheap. The best move comes from the last pass that failed high.
+    int mtdf(int player, int depth, int guess, int& move) {
+        int g = guess;
+        int lower = LosingValue - 1;
+        int upper = WinningValue + 1;
+        move = -1;
+        while(lower < upper) {
+            int beta = std::max(g, lower + 1);
+            g = alphabeta(player, beta - 1, beta, depth);
+            if(timeExpired) break;
+            if(g < beta) {
+                upper = g;
+            } else {
+                lower = g;
+                if(rootMove() != -1) move = rootMove();
+            }
+        }
+        if(move == -1) move = rootMove(); // Every pass failed low
+        return g;
+    }
+
+    int iterativeDeepening(int player, int maxDepth) {
+        int bestMove = -1;
+        timeExpired = false;
+        int lastScore = 0;
+        stats = SearchStats();
+        resetSearchStack();
+        maxDepth = std::min(timeManager.limitDepth(maxDepth), MaxSearchDepth);
+        
+        // Clear transposition table at start of search for new position
+        transTable.clear();
+        
+        // Start the timer
+        timeManager.startTimer();
+        
+        for(int depth = 1; depth <= maxDepth; depth++) {
+            // Check if we have enough time for another iteration
+            if(timeManager.getRemainingMs() < 100) { // Need at least 100ms for next depth
+                break;
+            }
+            
+            int move;
+            int score = (driver == MTDF) ? mtdf(player, depth, lastScore, move)
+                                         : aspirationSearch(player, depth, lastScore, move);
+            
+            // If time expired during search, use previous depth result
+            if(timeExpired) {
+                break;
+            }
+            
+            lastScore = score;
+            if(move != -1) {
+                bestMove = move;
+            }
+            
+            // Optional: Print search info
+            // printf("Depth %d completed in %dms, move: %d, score: %d\n", depth, timeManager.getElapsedMs(), bestMove, score);
+        }
+        
+        return bestMove;
+    }
+    
+    // Follow TT best moves from the current position to rebuild a PV
+    void extractPV(int player, int height, int maxLength, std::vector<int>& pv) {
+        std::vector<OthelloBoard::UndoInfo> undos;
+        std::vector<int> players;
+        while((int)undos.size() < maxLength) {
+            int sym;
+            TTEntry entry;
+            if(!transTable.probe(positionKey(player, height, sym), entry)) break;
+            int move = Symmetry::inverseSquare(entry.bestMove, sym);
+            if(move < 0 || !board.legalMove(move, player)) break;
+            pv.push_back(move);
+            undos.push_back(board.makeMoveWithUndo(move, player));
+            players.push_back(player);
+            player = board.opponent(player);
+            height++;
+        }
+        while(!undos.empty()) {
+            board.unmakeMove(undos.back(), players.back());
+            undos.pop_back();
+            players.pop_back();
+        }
+    }
+
+    // Multi-PV analysis: exact scores for the best numPV root moves and upper
+    // bounds for the rest. Each iteration searches the current top lines with
+    // a full window and tests the other moves with a zero window against the
+    // numPV-th best score, re-searching only those that beat it. The TT is
+    // shared by all lines. report is called after every completed depth.
+    std::vector<RootLine> analyze(int player, int maxDepth, int numPV,
+                                  std::function<void(int, const std::vector<RootLine>&)> report = nullptr) {
+        std::vector<RootLine> lines;
+        for(int i = 11; i <= 88; ++i) {
+            if(board.legalMove(i, player)) {
+                RootLine line;
+                line.move = i;
+                line.score = 0;
+                line.bound = TTEntry::UPPER_BOUND;
+                lines.push_back(line);
+            }
+        }
+        if(lines.empty() || numPV <= 0) return lines;
+
+        timeExpired = false;
+        transTable.clear();
+        stats = SearchStats();
+        resetSearchStack();
+        maxDepth = std::min(timeManager.limitDepth(maxDepth), MaxSearchDepth);
+        timeManager.startTimer();
+        std::vector<RootLine> completed = lines;
+
+        for(int depth = 1; depth <= maxDepth; depth++) {
+            if(timeManager.getRemainingMs() < 100) break;
+
+            std::vector<RootLine> current = completed;
+            std::vector<int> exactScores;
+            int kthScore = LosingValue - 1; // numPV-th best exact score so far
+            for(RootLine& line : current) {
+                OthelloBoard::UndoInfo undo = board.makeMoveWithUndo(line.move, player);
+                int opp = board.opponent(player);
+                int val;
+                if((int)exactScores.size() < numPV) {
+                    val = -alphabeta(opp, LosingValue - 1, WinningValue + 1, depth - 1, 1);
+                    line.bound = TTEntry::boundFor(val, LosingValue - 1, WinningValue + 1);
+                } else {
+                    val = -alphabeta(opp, -kthScore - 1, -kthScore, depth - 1, 1);
+                    line.bound = TTEntry::UPPER_BOUND;
+                    if(val > kthScore && !timeExpired) {
+                        // The re-search can still fail low (search instability)
+                        val = -alphabeta(opp, LosingValue - 1, -kthScore, depth - 1, 1);
+                        line.bound = TTEntry::boundFor(val, kthScore, WinningValue + 1);
+                    }
+                }
+                board.unmakeMove(undo, player);
+                if(timeExpired) break;
+
+                line.score = val;
+                if(line.bound == TTEntry::EXACT) {
+                    exactScores.push_back(val);
+                    std::sort(exactScores.begin(), exactScores.end(), std::greater<int>());
+                    if((int)exactScores.size() >= numPV) kthScore = exactScores[numPV - 1];
+                }
+            }
+            if(timeExpired) break;
+
+            // Best exact lines first; bounded moves below them
+            std::stable_sort(current.begin(), current.end(), [](const RootLine& a, const RootLine& b) {
+                if(a.score != b.score) return a.score > b.score;
+                return a.bound == TTEntry::EXACT && b.bound != TTEntry::EXACT;
+            });
+            // A line pushed out of the top numPV keeps its score, which is
+            // still a valid upper bound
+            int exactLines = 0;
+            for(RootLine& line : current) {
+                if(line.bound == TTEntry::EXACT && ++exactLines > numPV) line.bound = TTEntry::UPPER_BOUND;
+            }
+            for(RootLine& line : current) {
+                line.pv.assign(1, line.move);
+                if(line.bound != TTEntry::EXACT) continue;
+                OthelloBoard::UndoInfo undo = board.makeMoveWithUndo(line.move, player);
+                extractPV(board.opponent(player), 1, depth - 1, line.pv);
+                board.unmakeMove(undo, player);
+            }
+            completed = current;
+            if(report) report(depth, completed);
+        }
+        return completed;
+    }
+
+    // Final score of a finished game from P's side; empties go to the winner
+    static int finalScore(uint64_t P, uint64_t O, bool wld) {
+        int diff = Bitboard::popcount(P) - Bitboard::popcount(O);
+        if(wld) return (diff > 0) - (diff < 0);
+        int empties = 64 - Bitboard::popcount(P | O);
+        return diff > 0 ? diff + empties : diff < 0 ? diff - empties : 0;
+    }
+
+    // Exact endgame search on bitboards with no depth limit or heuristics.
+    // In WLD mode scores are clamped to -1/0/+1, so with the window (-1, 1)
+    // any bound of +-1 is already a proof and is stored in the TT as exact.
+    int solveEndgame(uint64_t P, uint64_t O, int alpha, int beta, bool wld, bool passed = false) {
+        stats.solveNodes++;
+        if(timeManager.budgetExhausted(stats.total())) timeExpired = true;
+        if(timeExpired) return alpha;
+
+        uint64_t moves = Bitboard::legalMoves(P, O);
+        if(!moves) {
+            if(passed) return finalScore(P, O, wld);
+            return -solveEndgame(O, P, -beta, -alpha, wld, true);
+        }
+
+        int empties = 64 - Bitboard::popcount(P | O);
+        int originalAlpha = alpha;
+        uint64_t key = 0;
+        int ttMove = -1;
+        if(empties >= SolveTTMinEmpties) {
+            key = Bitboard::hash(P, O) ^ SolveKeySalt[wld];
+            int ttValue;
+            if(transTable.lookup(key, empties, alpha, beta, ttValue, ttMove)) return ttValue;
+        }
+
+        // Order: TT move, then fastest-first (fewest opponent replies)
+        int order[64];
+        int count = 0;
+        for(uint64_t bits = moves; bits; bits &= bits - 1) order[count++] = __builtin_ctzll(bits);
+        if(empties > SolveOrderMinEmpties) {
+            int replies[64];
+            for(int i = 0; i < count; ++i) {
+                int bit = order[i];
+                uint64_t f = Bitboard::flips(P, O, bit);
+                replies[bit] = (bit == ttMove) ? -1 :
+                    Bitboard::popcount(Bitboard::legalMoves(O & ~f, P | f | (1ULL << bit)));
+            }
+            std::sort(order, order + count, [&replies](int a, int b) { return replies[a] < replies[b]; });
+        }
+
+        int bestVal = INT_MIN;
+        int bestMove = -1;
+        for(int i = 0; i < count; ++i) {
+            int bit = order[i];
+            uint64_t f = Bitboard::flips(P, O, bit);
+            int val = -solveEndgame(O & ~f, P | f | (1ULL << bit), -beta, -alpha, wld);
+            if(timeExpired) return alpha;
+            if(val > bestVal) {
+                bestVal = val;
+                bestMove = bit;
+                if(val > alpha) alpha = val;
+                if(alpha >= beta) break;
+            }
+        }
+
+        if(key) {
+            TTEntry::Flag flag = TTEntry::boundFor(bestVal, originalAlpha, beta);
+            if(wld && bestVal != 0) flag = TTEntry::EXACT;
+            transTable.store(key, bestVal, empties, bestMove, flag);
+        }
+        return bestVal;
+    }
+
+    // Solve the current position for player: win/loss/draw with the window
+    // (-1, 1), or the exact final disc difference. Uses the time and node budgets.
+    SolveResult solve(int player, bool wld) {
+        SolveResult result = {0, -1, false};
+        timeExpired = false;
+        stats = SearchStats();
+        transTable.clear();
+        timeManager.startTimer();
+
+        uint64_t P = board.bitboard(player);
+        uint64_t O = board.bitboard(board.opponent(player));
+        if(endgameSolver) {
+            result = endgameSolver->solve(P, O, wld, timeManager, stats);
+            timeExpired = !result.complete;
+            return result;
+        }
+        int alpha = wld ? -1 : -64, beta = wld ? 1 : 64;
+        uint64_t moves = Bitboard::legalMoves(P, O);
+        if(!moves) {
+            result.score = solveEndgame(P, O, alpha, beta, wld);
+            result.complete = !timeExpired;
+            return result;
+        }
+
+        int bestVal = INT_MIN;
+        for(uint64_t bits = moves; bits; bits &= bits - 1) {
+            int bit = __builtin_ctzll(bits);
+            uint64_t f = Bitboard::flips(P, O, bit);
+            int val = -solveEndgame(O & ~f, P | f | (1ULL << bit), -beta, -alpha, wld);
+            if(timeExpired) return result;
+            if(val > bestVal) {
+                bestVal = val;
+                result.move = Bitboard::bitToSquare(bit);
+                if(val > alpha) alpha = val;
+                if(alpha >= beta) break; // WLD: a proven win needs no more moves
+            }
+        }
+        result.score = bestVal;
+        result.complete = true;
+        return result;
+    }
+
+    // Pick a move for player: a win/loss/draw solve when few empties remain
+    // and it proves a win or draw in time, iterative deepening otherwise
+    int chooseMove(int player, int maxDepth) {
+        int empties = 64 - board.countPieces();
+        if(empties > wldEmpties) return iterativeDeepening(player, maxDepth);
+
+        SolveResult result = solve(player, true);
+        if(result.complete && result.score >= 0 && result.move != -1) return result.move;
+
+        // Lost or out of budget: search heuristically with what is left of
+        // the time and node budgets; stats then covers both searches
+        uint64_t solveNodes = stats.solveNodes;
+        int limit = timeManager.getTimeLimitMs();
+        uint64_t nodeLimit = timeManager.getNodeLimit();
+        timeManager.setTimeLimit(std::max(timeManager.getRemainingMs(), MinSearchMs));
+        if(nodeLimit) timeManager.setNodeLimit(std::max(nodeLimit > solveNodes ? nodeLimit - solveNodes : 0, MinSearchNodes));
+        int move = iterativeDeepening(player, maxDepth);
+        stats.solveNodes = solveNodes;
+        timeManager.setTimeLimit(limit);
+        timeManager.setNodeLimit(nodeLimit);
+        return move;
+    }
+
+    // Adaptive time management based on game phase
+    void adjustTimeLimit() {
+        int totalPieces = 0;
+        for(int i = 0; i < 100; i++) {
+            if(board.board[i] == OthelloBoard::BLACK || board.board[i] == OthelloBoard::WHITE) {
+                totalPieces++;
+            }
+        }
+        
+        // Adjust time based on game phase
+        if(totalPieces <= 20) {
+            // Opening: use less time
+            timeManager.setTimeLimit(1500); // 1.5 seconds
+        } else if(totalPieces <= 50) {
+            // Midgame: use standard time
+            timeManager.setTimeLimit(2000); // 2 seconds
+        } else {
+            // Endgame: use more time for critical decisions
+            timeManager.setTimeLimit(3000); // 3 seconds
+        }
+    }
+};
+
+#endif // OTHELLO_ENGINE_H
@@ -0,0 +1,169 @@
+"""
+ctypes binding for the C++ engine in libothello.so (build with `make lib`).
+
+Boards are the same 100-element 10x10 lists used by othello.py
+(EMPTY=0, BLACK=1, WHITE=2, OUTER=3, index = (row + 1) * 10 + (col + 1)).
+Every call loads the board into a native engine, so the functions are
+stateless from Python's point of view. ctypes releases the GIL for the
+duration of each native call, so searches can run in worker threads.
+"""
+import ctypes
+import os
+from typing import List, NamedTuple, Optional
+
+BOARD_CELLS = 100
+MAX_MOVES = 64
+MAX_PV = 60
+
+# Score bounds of analyze() lines (othello_capi.h OTHELLO_BOUND_*)
+BOUND_EXACT = 0
+BOUND_LOWER = 1
+BOUND_UPPER = 2
+
+_LIB_NAME = "libothello.so"
+
+
+class _Line(ctypes.Structure):
+    _fields_ = [("move", ctypes.c_int), ("score", ctypes.c_int), ("bound", ctypes.c_int),
+                ("pv_length", ctypes.c_int), ("pv", ctypes.c_int * MAX_PV)]
+
+
+class Line(NamedTuple):
+    """One root move from analyze(): its score, bound and principal variation."""
+    move: int
+    score: int
+    bound: int      # BOUND_EXACT for the best num_pv moves, BOUND_UPPER below them
+    pv: List[int]   # Starts with move
+
+
+def _load_library() -> ctypes.CDLL:
+    """Loads libothello.so from $OTHELLO_LIB or next to this file."""
+    path = os.environ.get("OTHELLO_LIB")
+    if not path:
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), _LIB_NAME)
+    lib = ctypes.CDLL(path)
+
+    cells = ctypes.POINTER(ctypes.c_int)
+    lib.othello_engine_new.restype = ctypes.c_void_p
+    lib.othello_engine_new.argtypes = []
+    lib.othello_engine_free.restype = None
+    lib.othello_engine_free.argtypes = [ctypes.c_void_p]
+    lib.othello_set_board.restype = None
+    lib.othello_set_board.argtypes = [ctypes.c_void_p, cells]
+    lib.othello_get_board.restype = None
+    lib.othello_get_board.argtypes = [ctypes.c_void_p, cells]
+    lib.othello_legal_moves.restype = ctypes.c_int
+    lib.othello_legal_moves.argtypes = [ctypes.c_void_p, ctypes.c_int, cells, ctypes.c_int]
+    lib.othello_make_move.restype = ctypes.c_int
+    lib.othello_make_move.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+    lib.othello_evaluate.restype = ctypes.c_int
+    lib.othello_evaluate.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.othello_load_network.restype = ctypes.c_int
+    lib.othello_load_network.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.othello_search.restype = ctypes.c_int
+    lib.othello_search.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int]
+    lib.othello_analyze.restype = ctypes.c_int
+    lib.othello_analyze.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_int,
+                                    ctypes.POINTER(_Line), ctypes.c_int]
+    lib.othello_set_limits.restype = None
+    lib.othello_set_limits.argtypes = [ctypes.c_void_p, ctypes.c_ulonglong, ctypes.c_int]
+    lib.othello_set_wld_empties.restype = None
+    lib.othello_set_wld_empties.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.othello_set_solver_threads.restype = None
+    lib.othello_set_solver_threads.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    return lib
+
+
+_lib = _load_library()
+
+
+class Engine:
+    """A native engine instance. Not thread-safe: use one per thread."""
+
+    def __init__(self):
+        self._handle = _lib.othello_engine_new()
+        if not self._handle:
+            raise MemoryError("othello_engine_new failed")
+        self._cells = (ctypes.c_int * BOARD_CELLS)()
+        self._moves = (ctypes.c_int * MAX_MOVES)()
+        self._lines = (_Line * MAX_MOVES)()
+
+    def close(self):
+        """Frees the native engine."""
+        if self._handle:
+            _lib.othello_engine_free(self._handle)
+            self._handle = None
+
+    def __del__(self):
+        self.close()
+
+    def _load(self, board: List[int]):
+        if len(board) != BOARD_CELLS:
+            raise ValueError(f"board must have {BOARD_CELLS} cells, got {len(board)}")
+        self._cells[:] = board
+        _lib.othello_set_board(self._handle, self._cells)
+
+    def legal_moves(self, board: List[int], player: int) -> List[int]:
+        """Returns the legal move indices for player, in index order."""
+        self._load(board)
+        count = _lib.othello_legal_moves(self._handle, player, self._moves, MAX_MOVES)
+        return list(self._moves[:count])
+
+    def make_move(self, board: List[int], move: int, player: int) -> Optional[List[int]]:
+        """Returns the board after player plays move, or None if it is illegal."""
+        self._load(board)
+        if _lib.othello_make_move(self._handle, move, player) < 0:
+            return None
+        _lib.othello_get_board(self._handle, self._cells)
+        return list(self._cells)
+
+    def evaluate(self, board: List[int], player: int) -> int:
+        """Static evaluation of board from player's point of view."""
+        self._load(board)
+        return _lib.othello_evaluate(self._handle, player)
+
+    def load_network(self, path: Optional[str]):
+        """Evaluates with a neural network weight file (see nnue.h); None
+        returns to the built-in evaluation. Raises OSError if loading fails."""
+        encoded = None if path is None else os.fsencode(path)
+        if _lib.othello_load_network(self._handle, encoded) != 0:
+            raise OSError(f"cannot load network weights from {path}")
+
+    def search(self, board: List[int], player: int, max_depth: int, time_ms: int = 0) -> Optional[int]:
+        """
+        Iterative deepening search to max_depth, stopping after time_ms
+        milliseconds (0 = no time limit). Near the end of the game a
+        win/loss/draw solve is tried first (see set_wld_empties). Returns the
+        best move or None if player has no legal move. The GIL is released
+        while searching.
+        """
+        self._load(board)
+        move = _lib.othello_search(self._handle, player, max_depth, time_ms)
+        return None if move < 0 else move
+
+    def analyze(self, board: List[int], player: int, max_depth: int, num_pv: int,
+                time_ms: int = 0) -> List[Line]:
+        """
+        Multi-PV analysis to max_depth, stopping after time_ms milliseconds
+        (0 = no time limit): every root move, best first, with exact scores
+        and principal variations for the best num_pv moves and upper bounds
+        for the rest. Empty if player has no legal move. The GIL is released
+        while searching.
+        """
+        self._load(board)
+        count = _lib.othello_analyze(self._handle, player, max_depth, time_ms, num_pv, self._lines, MAX_MOVES)
+        return [Line(line.move, line.score, line.bound, list(line.pv[:line.pv_length]))
+                for line in self._lines[:count]]
+
+    def set_limits(self, max_nodes: int = 0, max_depth: int = 0):
+        """Sets node and depth budgets for search() and analyze() (0 = unlimited).
+        With time_ms=0 a node budget makes searches reproducible."""
+        _lib.othello_set_limits(self._handle, max_nodes, max_depth)
+
+    def set_wld_empties(self, empties: int):
+        """Sets the empties at or below which search() solves win/loss/draw (0 = never)."""
+        _lib.othello_set_wld_empties(self._handle, empties)
+
+    def set_solver_threads(self, threads: int):
+        """Sets the threads for endgame solves (1 = serial, 0 = every core)."""
+        _lib.othello_set_solver_threads(self._handle, threads)
@@ -0,0 +1,337 @@
+// Engine-vs-engine matches: two engine configurations play each opening of
+// a balanced set twice with colors swapped, many games at once on a shared
+// thread pool. Results stream as games finish with the running Elo estimate
+// (95% error bars) and, with -s, a sequential probability ratio test that
+// stops the match once it accepts either hypothesis.
+#include "othello_engine.h"
+#include "position_file.h"
+#include "thread_pool.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    struct EngineConfig {
+        std::string name;
+        OthelloEngine::SearchDriver driver = OthelloEngine::ASPIRATION;
+        int timeMs = 0;          // Per move, 0 = no time limit
+        uint64_t nodes = 20000;  // Per move, 0 = unlimited
+        int depth = MaxSearchDepth;
+        int wldEmpties = DefaultWldEmpties;
+        size_t ttMegabytes = 16; // Transposition table, rounded down to a power of two
+        std::shared_ptr<const Nnue::Network> network;
+    };
+
+    struct Options {
+        EngineConfig engines[2];
+        int threads = 0;
+        int maxGames = 1000;
+        int openingPlies = 8;
+        int balance = 40;        // Max |score| of a generated opening at BalanceDepth
+        const char* openings = nullptr;
+        bool sprt = false;
+        double elo0 = 0, elo1 = 10, alpha = 0.05, beta = 0.05;
+        bool quiet = false;
+    };
+
+    const int BalanceDepth = 4;
+
+    // "key=value,..." over the defaults; false on an unknown key or bad value
+    bool parseConfig(const char* text, EngineConfig& config) {
+        std::string spec(text);
+        size_t start = 0;
+        while(start < spec.size()) {
+            size_t end = spec.find(',', start);
+            if(end == std::string::npos) end = spec.size();
+            std::string item = spec.substr(start, end - start);
+            start = end + 1;
+            size_t eq = item.find('=');
+            if(eq == std::string::npos) return false;
+            std::string key = item.substr(0, eq), value = item.substr(eq + 1);
+            if(key == "name") config.name = value;
+            else if(key == "driver" && (value == "aspiration" || value == "mtdf"))
+                config.driver = value == "mtdf" ? OthelloEngine::MTDF : OthelloEngine::ASPIRATION;
+            else if(key == "time") config.timeMs = std::max(0, atoi(value.c_str()));
+            else if(key == "nodes") config.nodes = strtoull(value.c_str(), nullptr, 10);
+            else if(key == "depth") config.depth = std::max(1, atoi(value.c_str()));
+            else if(key == "wld") config.wldEmpties = std::max(0, atoi(value.c_str()));
+            else if(key == "tt" && atoi(value.c_str()) > 0) config.ttMegabytes = (size_t)atoi(value.c_str());
+            else if(key == "weights") {
+                std::shared_ptr<Nnue::Network> network(new Nnue::Network());
+                if(!network->load(value.c_str())) return false;
+                config.network = network;
+            }
+            else return false;
+        }
+        return true;
+    }
+
+    void configure(OthelloEngine& engine, const EngineConfig& config) {
+        engine.driver = config.driver;
+        engine.wldEmpties = config.wldEmpties;
+        engine.transTable.setCapacity(config.ttMegabytes * 1024 * 1024 / TTBytesPerEntry);
+        engine.timeManager.enableTimeLimit(config.timeMs > 0);
+        if(config.timeMs > 0) engine.timeManager.setTimeLimit(config.timeMs);
+        engine.timeManager.setNodeLimit(config.nodes);
+        if(config.network) engine.setNetwork(config.network);
+    }
+
+    // Random playouts of the given length from the start position, kept when
+    // a shallow search rates the side to move within balance
+    std::vector<PackedBoard> generateOpenings(int count, int plies, int balance) {
+        std::mt19937 rng(20240917);
+        std::vector<PackedBoard> openings;
+        OthelloEngine judge;
+        judge.timeManager.enableTimeLimit(false);
+        for(int attempts = 0; (int)openings.size() < count && attempts < count * 100; ++attempts) {
+            OthelloBoard board;
+            int player = OthelloBoard::BLACK;
+            for(int ply = 0; ply < plies; ++ply) {
+                std::vector<int> moves;
+                for(int i = 11; i <= 88; ++i) {
+                    if(board.legalMove(i, player)) moves.push_back(i);
+                }
+                if(moves.empty()) break;
+                board.makeMove(moves[rng() % moves.size()], player);
+                player = board.opponent(player);
+            }
+            if(!board.hasLegalMoves(player)) continue;
+            judge.board.setPosition(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+            std::vector<RootLine> best = judge.analyze(player, BalanceDepth, 1);
+            if(!best.empty() && std::abs(best[0].score) <= balance) openings.push_back(PackedBoard::pack(board, player));
+        }
+        return openings;
+    }
+
+    bool loadOpenings(const char* path, std::vector<PackedBoard>& openings) {
+        PositionReader reader;
+        if(!reader.open(path)) return false;
+        PackedBoard position;
+        while(reader.next(position)) openings.push_back(position);
+        return !reader.error();
+    }
+
+    // Plays one game to the end; returns black's disc count minus white's
+    int playGame(const PackedBoard& opening, const EngineConfig& blackConfig, const EngineConfig& whiteConfig) {
+        OthelloEngine engines[2];
+        configure(engines[0], blackConfig);
+        configure(engines[1], whiteConfig);
+        const EngineConfig* configs[2] = {&blackConfig, &whiteConfig};
+        OthelloBoard board;
+        int player;
+        opening.unpack(board, player);
+        for(;;) {
+            if(!board.hasLegalMoves(player)) {
+                player = board.opponent(player);
+                if(!board.hasLegalMoves(player)) break;
+            }
+            int side = player == OthelloBoard::BLACK ? 0 : 1;
+            OthelloEngine& engine = engines[side];
+            engine.board.setPosition(board.bitboard(OthelloBoard::BLACK), board.bitboard(OthelloBoard::WHITE));
+            int move = engine.chooseMove(player, configs[side]->depth);
+            if(move == -1 || !board.legalMove(move, player)) {
+                // Budget ran out before depth 1 finished: first legal move
+                for(move = 11; !board.legalMove(move, player); ++move) {}
+            }
+            board.makeMove(move, player);
+            player = board.opponent(player);
+        }
+        return board.countDiscs(OthelloBoard::BLACK) - board.countDiscs(OthelloBoard::WHITE);
+    }
+
+    // Trinomial results of engine A against B
+    struct MatchStats {
+        int wins = 0, draws = 0, losses = 0;
+
+        int games() const { return wins + draws + losses; }
+        double score() const { return games() ? (wins + 0.5 * draws) / games() : 0.5; }
+
+        // Per-game score variance
+        double variance() const {
+            double s = score();
+            return games() ? (wins * (1 - s) * (1 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / games() : 0;
+        }
+
+        static double elo(double score) {
+            return -400 * std::log10(1 / score - 1);
+        }
+
+        static double scoreOf(double elo) {
+            return 1 / (1 + std::pow(10, -elo / 400));
+        }
+
+        // Elo difference with a 95% confidence half-width; false while the
+        // score is 0 or 1 and the estimate is unbounded
+        bool estimate(double& value, double& margin) const {
+            double s = score();
+            if(!games() || s <= 0 || s >= 1) return false;
+            double error = 1.96 * std::sqrt(variance() / games());
+            double low = std::max(1e-6, s - error), high = std::min(1 - 1e-6, s + error);
+            value = elo(s);
+            margin = (elo(high) - elo(low)) / 2;
+            return true;
+        }
+
+        // Log-likelihood ratio of elo1 over elo0 (normal approximation, as in
+        // the generalized SPRT used by engine testing frameworks)
+        double llr(double elo0, double elo1) const {
+            double var = variance();
+            if(!games() || var <= 0) return 0;
+            double s0 = scoreOf(elo0), s1 = scoreOf(elo1);
+            return games() * (s1 - s0) * (2 * score() - s0 - s1) / (2 * var);
+        }
+    };
+
+    class Match {
+    private:
+        const Options& options;
+        const std::vector<PackedBoard>& openings;
+        std::mutex mutex;
+        MatchStats stats;
+        std::atomic<bool> finished;
+        const char* verdict;
+        double lowerBound, upperBound;
+
+    public:
+        Match(const Options& opts, const std::vector<PackedBoard>& sets)
+            : options(opts), openings(sets), finished(false), verdict(nullptr),
+              lowerBound(std::log(opts.beta / (1 - opts.alpha))), upperBound(std::log((1 - opts.beta) / opts.alpha)) {}
+
+        // Game g plays opening g/2 with A as black on even g, as white on odd g
+        void playGame(int g) {
+            if(finished) return;
+            const PackedBoard& opening = openings[(g / 2) % openings.size()];
+            bool aBlack = g % 2 == 0;
+            const EngineConfig& a = options.engines[0];
+            const EngineConfig& b = options.engines[1];
+            int diff = ::playGame(opening, aBlack ? a : b, aBlack ? b : a);
+            int aDiff = aBlack ? diff : -diff;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if(finished) return; // Decided while this game was running
+            if(aDiff > 0) stats.wins++;
+            else if(aDiff < 0) stats.losses++;
+            else stats.draws++;
+            if(!options.quiet) {
+                printf("game %4d  opening %3d  %s as %s  %+3d  ", g + 1, (int)((g / 2) % openings.size()) + 1,
+                       a.name.c_str(), aBlack ? "black" : "white", aDiff);
+                printStatus();
+            }
+            if(options.sprt) {
+                double llr = stats.llr(options.elo0, options.elo1);
+                if(llr >= upperBound) verdict = "H1 accepted";
+                else if(llr <= lowerBound) verdict = "H0 accepted";
+                if(verdict) finished = true;
+            }
+        }
+
+        // W-D-L, Elo and LLR on one line
+        void printStatus() {
+            printf("W %d D %d L %d", stats.wins, stats.draws, stats.losses);
+            double elo, margin;
+            if(stats.estimate(elo, margin)) printf("  elo %+.1f +/- %.1f", elo, margin);
+            if(options.sprt) printf("  llr %.2f [%.2f, %.2f]", stats.llr(options.elo0, options.elo1), lowerBound, upperBound);
+            printf("\n");
+            fflush(stdout);
+        }
+
+        void summary() {
+            std::lock_guard<std::mutex> lock(mutex);
+            printf("%s vs %s: %d games, score %.1f%%  ", options.engines[0].name.c_str(),
+                   options.engines[1].name.c_str(), stats.games(), 100 * stats.score());
+            printStatus();
+            if(options.sprt) {
+                printf("sprt elo0 %.1f elo1 %.1f: %s\n", options.elo0, options.elo1,
+                       verdict ? verdict : "inconclusive (game limit reached)");
+            }
+        }
+    };
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_match [options]\n"
+            "  -a CONFIG     engine A, e.g. name=new,driver=mtdf,nodes=50000\n"
+            "  -b CONFIG     engine B (keys: name, driver, time, nodes, depth, wld, tt, weights;\n"
+            "                default nodes=20000 per move, no time limit, tt=16 MB)\n"
+            "  -g GAMES      maximum number of games (default 1000)\n"
+            "  -j N          games played in parallel (default: all cores); each game holds\n"
+            "                both engines' tables, so N * (tt of A + tt of B) MB in all\n"
+            "  -O FILE       openings from a position file instead of generated ones\n"
+            "  -p PLIES      length of generated openings (default 8)\n"
+            "  -B SCORE      keep generated openings a depth-%d search scores within SCORE (default 40)\n"
+            "  -s E0,E1[,ALPHA,BETA]  stop early on an SPRT of elo E0 vs E1 (default alpha = beta = 0.05)\n"
+            "  -q            only print the summary\n", BalanceDepth);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    options.engines[0].name = "A";
+    options.engines[1].name = "B";
+    int opt;
+    while((opt = getopt(argc, argv, "a:b:g:j:O:p:B:s:qh")) != -1) {
+        switch(opt) {
+            case 'a':
+            case 'b':
+                if(!parseConfig(optarg, options.engines[opt == 'a' ? 0 : 1])) {
+                    fprintf(stderr, "othello_match: bad engine configuration %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'g': options.maxGames = std::max(1, atoi(optarg)); break;
+            case 'j': options.threads = atoi(optarg); break;
+            case 'O': options.openings = optarg; break;
+            case 'p': options.openingPlies = std::max(0, atoi(optarg)); break;
+            case 'B': options.balance = std::max(0, atoi(optarg)); break;
+            case 's': {
+                int fields = sscanf(optarg, "%lf,%lf,%lf,%lf", &options.elo0, &options.elo1, &options.alpha, &options.beta);
+                if(fields < 2 || options.elo1 <= options.elo0 || options.alpha <= 0 || options.alpha >= 1 ||
+                   options.beta <= 0 || options.beta >= 1) {
+                    usage();
+                    return 1;
+                }
+                options.sprt = true;
+                break;
+            }
+            case 'q': options.quiet = true; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(optind < argc) {
+        usage();
+        return 1;
+    }
+
+    Zobrist::init(); // Before any game thread builds a board
+    std::vector<PackedBoard> openings;
+    if(options.openings) {
+        if(!loadOpenings(options.openings, openings) || openings.empty()) {
+            fprintf(stderr, "othello_match: cannot read openings from %s\n", options.openings);
+            return 1;
+        }
+    } else {
+        openings = generateOpenings((options.maxGames + 1) / 2, options.openingPlies, options.balance);
+        if(openings.empty()) {
+            fprintf(stderr, "othello_match: no opening within -B %d found\n", options.balance);
+            return 1;
+        }
+    }
+    printf("%s vs %s: up to %d games from %zu openings\n", options.engines[0].name.c_str(),
+           options.engines[1].name.c_str(), options.maxGames, openings.size());
+    fflush(stdout);
+
+    Match match(options, openings);
+    {
+        ThreadPool pool(options.threads);
+        for(int g = 0; g < options.maxGames; ++g) pool.submit([&match, g]() { match.playGame(g); });
+    } // The pool drains: games after an SPRT decision return at once
+    match.summary();
+    return 0;
+}
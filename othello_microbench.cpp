@@ -0,0 +1,314 @@
+// Micro-benchmarks of the board and search primitives: move generation,
+// make/unmake, flip counting, every evaluation term and the transposition
+// table, each timed over the same fixed position set as othello_bench.
+// Results print as ns/op and ops/s; -o saves them and -c compares a run
+// against a saved file, so two builds can be diffed ("make bench").
+#include "bench_positions.h"
+#include "othello_engine.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    // Results feed this so the compiler can't drop the measured calls
+    volatile uint64_t sink;
+
+    struct Result {
+        std::string name;
+        double nsPerOp;
+    };
+
+    struct Options {
+        double minSeconds = 0.2;
+        int count = 256;
+        const char* filter = nullptr;
+        const char* output = nullptr;
+        const char* baseline = nullptr;
+    };
+
+    // The position set, unpacked once
+    struct Fixture {
+        std::vector<OthelloBoard> boards;
+        std::vector<int> players;
+        std::vector<std::vector<int>> moves; // Legal moves of each position
+        std::vector<uint64_t> own, other;    // Bitboards of the side to move and the opponent
+
+        explicit Fixture(int count) {
+            // 4..56 plies in, so every evaluation phase is covered
+            for(const BenchPosition& bench : benchPositions(count, 4, 56)) {
+                boards.push_back(OthelloBoard());
+                players.push_back(0);
+                bench.position.unpack(boards.back(), players.back());
+                std::vector<int> legal;
+                for(int i = 11; i <= 88; ++i) {
+                    if(boards.back().legalMove(i, players.back())) legal.push_back(i);
+                }
+                moves.push_back(legal);
+                own.push_back(boards.back().bitboard(players.back()));
+                other.push_back(boards.back().bitboard(boards.back().opponent(players.back())));
+            }
+        }
+    };
+
+    // Repeats pass (which returns the operations it did) until minSeconds
+    // have elapsed, after one warm-up pass
+    Result measure(const char* name, const Options& options, const std::function<uint64_t()>& pass) {
+        pass();
+        uint64_t ops = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            ops += pass();
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while(elapsed < options.minSeconds);
+        Result result = {name, ops ? elapsed * 1e9 / ops : 0.0};
+        return result;
+    }
+
+    // Each evaluation term over the whole set, one op per position
+    uint64_t evalPass(Fixture& fixture, int (OthelloBoard::*term)(int) const) {
+        uint64_t sum = 0;
+        for(size_t i = 0; i < fixture.boards.size(); ++i) sum += (fixture.boards[i].*term)(fixture.players[i]);
+        sink = sink + sum;
+        return fixture.boards.size();
+    }
+
+    std::vector<Result> runAll(Fixture& fixture, const Options& options) {
+        std::vector<std::pair<const char*, std::function<uint64_t()>>> benches;
+        benches.push_back({"legalMove", [&]() {
+            uint64_t sum = 0, ops = 0;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                for(int square = 11; square <= 88; ++square) {
+                    if(square % 10 == 0 || square % 10 == 9) continue;
+                    sum += fixture.boards[i].legalMove(square, fixture.players[i]);
+                    ops++;
+                }
+            }
+            sink = sink + sum;
+            return ops;
+        }});
+        benches.push_back({"hasLegalMoves", [&]() {
+            uint64_t sum = 0;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                const OthelloBoard& board = fixture.boards[i];
+                sum += board.hasLegalMoves(board.opponent(fixture.players[i]));
+            }
+            sink = sink + sum;
+            return (uint64_t)fixture.boards.size();
+        }});
+        benches.push_back({"Bitboard::legalMoves", [&]() {
+            uint64_t sum = 0;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                sum += Bitboard::legalMoves(fixture.own[i], fixture.other[i]);
+            }
+            sink = sink + sum;
+            return (uint64_t)fixture.boards.size();
+        }});
+        benches.push_back({"makeMoveWithUndo+unmake", [&]() {
+            uint64_t sum = 0, ops = 0;
+            OthelloBoard::UndoInfo undo;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                OthelloBoard& board = fixture.boards[i];
+                for(int move : fixture.moves[i]) {
+                    board.makeMoveWithUndo(move, fixture.players[i], undo);
+                    sum += undo.flipCount;
+                    board.unmakeMove(undo, fixture.players[i]);
+                    ops++;
+                }
+            }
+            sink = sink + sum;
+            return ops;
+        }});
+        benches.push_back({"countFlipsForMove", [&]() {
+            uint64_t sum = 0, ops = 0;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                for(int move : fixture.moves[i]) {
+                    sum += countFlipsForMove(fixture.boards[i], move, fixture.players[i]);
+                    ops++;
+                }
+            }
+            sink = sink + sum;
+            return ops;
+        }});
+        benches.push_back({"advancedEvaluation", [&]() { return evalPass(fixture, &OthelloBoard::advancedEvaluation); }});
+        benches.push_back({"eval.mobility", [&]() { return evalPass(fixture, &OthelloBoard::mobility); }});
+        benches.push_back({"eval.cornerControl", [&]() { return evalPass(fixture, &OthelloBoard::cornerControl); }});
+        benches.push_back({"eval.edgeControl", [&]() { return evalPass(fixture, &OthelloBoard::edgeControl); }});
+        benches.push_back({"eval.stability", [&]() { return evalPass(fixture, &OthelloBoard::stability); }});
+        benches.push_back({"eval.dangerousSquares", [&]() { return evalPass(fixture, &OthelloBoard::dangerousSquares); }});
+        benches.push_back({"eval.parity", [&]() { return evalPass(fixture, &OthelloBoard::parity); }});
+        benches.push_back({"LeafBatch children", [&]() {
+            // The search's batched path: all children of a position, one op per child
+            uint64_t sum = 0, ops = 0;
+            LeafBatch batch;
+            for(size_t i = 0; i < fixture.boards.size(); ++i) {
+                uint64_t P = fixture.own[i], O = fixture.other[i];
+                batch.clear();
+                for(int move : fixture.moves[i]) {
+                    int bit = Bitboard::squareToBit(move);
+                    uint64_t flipped = Bitboard::flips(P, O, bit);
+                    batch.add(O & ~flipped, P | flipped | (1ULL << bit));
+                }
+                batch.evaluate();
+                for(int c = 0; c < batch.count; ++c) sum += batch.score[c];
+                ops += batch.count;
+            }
+            sink = sink + sum;
+            return ops;
+        }});
+
+        // TT keys of every position and child, as the search would store them
+        std::vector<uint64_t> keys;
+        for(size_t i = 0; i < fixture.boards.size(); ++i) {
+            OthelloBoard& board = fixture.boards[i];
+            keys.push_back(board.getZobristKey(fixture.players[i]));
+            for(int move : fixture.moves[i]) {
+                OthelloBoard::UndoInfo undo;
+                board.makeMoveWithUndo(move, fixture.players[i], undo);
+                keys.push_back(board.getZobristKey(board.opponent(fixture.players[i])));
+                board.unmakeMove(undo, fixture.players[i]);
+            }
+        }
+        TranspositionTable table;
+        benches.push_back({"TT store", [&]() {
+            table.clear();
+            for(size_t i = 0; i < keys.size(); ++i) {
+                table.store(keys[i], (int)(i & 255), (int)(i % 8), 44, TTEntry::EXACT);
+            }
+            return (uint64_t)keys.size();
+        }});
+        // Lookups get their own filled tables, so they hit whatever else runs
+        // or is filtered out. Hot: the fixture keys, whose few thousand
+        // buckets stay in L1/L2 between passes. Cold: four random keys per
+        // entry of a default-sized table, so the lookups range over all of
+        // its 16 MB in an order the prefetcher can't follow.
+        TranspositionTable filled;
+        filled.clear();
+        for(size_t i = 0; i < keys.size(); ++i) filled.store(keys[i], (int)(i & 255), (int)(i % 8), 44, TTEntry::EXACT);
+        benches.push_back({"TT lookup hot", [&]() {
+            uint64_t sum = 0;
+            for(size_t i = 0; i < keys.size(); ++i) {
+                int value, move;
+                sum += filled.lookup(keys[i], 0, -1000, 1000, value, move);
+            }
+            sink = sink + sum;
+            return (uint64_t)keys.size();
+        }});
+        std::vector<uint64_t> coldKeys;
+        TranspositionTable cold;
+        benches.push_back({"TT lookup cold", [&]() {
+            if(coldKeys.empty()) {
+                // Built on the first (warm-up) pass, so nothing is allocated when filtered out
+                std::mt19937_64 rng(20240601);
+                coldKeys.resize(4 * cold.size());
+                for(uint64_t& key : coldKeys) key = rng();
+                cold.clear();
+                for(size_t i = 0; i < coldKeys.size(); ++i) {
+                    cold.store(coldKeys[i], (int)(i & 255), (int)(i % 8), 44, TTEntry::EXACT);
+                }
+            }
+            uint64_t sum = 0;
+            for(size_t i = 0; i < coldKeys.size(); ++i) {
+                int value, move;
+                sum += cold.lookup(coldKeys[i], 0, -1000, 1000, value, move);
+            }
+            sink = sink + sum;
+            return (uint64_t)coldKeys.size();
+        }});
+
+        std::vector<Result> results;
+        for(const auto& bench : benches) {
+            if(options.filter && !strstr(bench.first, options.filter)) continue;
+            results.push_back(measure(bench.first, options, bench.second));
+        }
+        return results;
+    }
+
+    // Saved results: "name<TAB>ns/op" per line, # comments
+    bool readResults(const char* path, std::map<std::string, double>& results) {
+        FILE* file = fopen(path, "r");
+        if(!file) return false;
+        char line[256];
+        while(fgets(line, sizeof(line), file)) {
+            if(line[0] == '#') continue;
+            char* tab = strchr(line, '\t');
+            if(!tab) continue;
+            *tab = 0;
+            results[line] = atof(tab + 1);
+        }
+        fclose(file);
+        return true;
+    }
+
+    bool writeResults(const char* path, const std::vector<Result>& results, int count) {
+        FILE* file = fopen(path, "w");
+        if(!file) return false;
+        fprintf(file, "# othello_microbench: %d positions, ns/op, %s\n", count,
+                Nnue::avx2Enabled() ? "avx2" : "scalar");
+        for(const Result& result : results) fprintf(file, "%s\t%.3f\n", result.name.c_str(), result.nsPerOp);
+        return fclose(file) == 0;
+    }
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_microbench [options]\n"
+            "  -t SECONDS minimum time per benchmark (default 0.2)\n"
+            "  -n COUNT   number of positions (default 256)\n"
+            "  -f NAME    only benchmarks whose name contains NAME\n"
+            "  -o FILE    save results to FILE\n"
+            "  -c FILE    compare with results saved earlier in FILE\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int opt;
+    while((opt = getopt(argc, argv, "t:n:f:o:c:h")) != -1) {
+        switch(opt) {
+            case 't': options.minSeconds = std::max(0.001, atof(optarg)); break;
+            case 'n': options.count = std::max(1, atoi(optarg)); break;
+            case 'f': options.filter = optarg; break;
+            case 'o': options.output = optarg; break;
+            case 'c': options.baseline = optarg; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if(optind < argc) {
+        usage();
+        return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    if(options.baseline && !readResults(options.baseline, baseline)) {
+        fprintf(stderr, "othello_microbench: cannot read %s\n", options.baseline);
+        return 1;
+    }
+
+    Zobrist::init();
+    Fixture fixture(options.count);
+    std::vector<Result> results = runAll(fixture, options);
+    printf("%-26s %12s %14s%s\n", "benchmark", "ns/op", "ops/s", options.baseline ? "    vs baseline" : "");
+    for(const Result& result : results) {
+        printf("%-26s %12.2f %14.0f", result.name.c_str(), result.nsPerOp,
+               result.nsPerOp > 0 ? 1e9 / result.nsPerOp : 0.0);
+        auto old = baseline.find(result.name);
+        if(old != baseline.end() && old->second > 0) printf("    %+6.1f%%", 100.0 * (result.nsPerOp / old->second - 1));
+        printf("\n");
+    }
+
+    if(options.output) {
+        if(!writeResults(options.output, results, options.count)) {
+            fprintf(stderr, "othello_microbench: cannot write %s\n", options.output);
+            return 1;
+        }
+        printf("results saved to %s\n", options.output);
+    }
+    return 0;
+}
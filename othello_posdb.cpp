@@ -0,0 +1,240 @@
+// Sort, deduplicate and merge position files with a bounded-memory external
+// merge sort. Output files are sorted by (black, white) with duplicates removed.
+#include "othello_board.h"
+#include "position_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    const size_t MaxMergeFanIn = 128;    // Open run files per merge pass
+    const size_t MinBufferRecords = 256; // 4 KiB: smallest I/O buffer per open file
+    const size_t RunBufferShare = 16;    // The run phase's reader and writer each buffer 1/16 of the budget
+
+    // The smallest budget (-m 1) must still hold a full merge pass
+    static_assert((MaxMergeFanIn + 1) * MinBufferRecords * PositionFile::RecordSize <= 1024 * 1024,
+                  "merge buffers exceed the minimum memory budget");
+
+    struct Options {
+        const char* output = nullptr;
+        std::string tempDir = ".";
+        size_t memoryMB = 256;
+        bool symmetry = false;
+        bool presorted = false;
+        std::vector<const char*> inputs;
+    };
+
+    struct MergeHead {
+        PackedBoard position;
+        size_t source;
+        bool operator>(const MergeHead& other) const {
+            return other.position < position;
+        }
+    };
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_posdb [options] -o OUTPUT INPUT...\n"
+            "  -o FILE  output position file (sorted, duplicates removed)\n"
+            "  -m MB    memory budget for runs and merge buffers (default 256)\n"
+            "  -s       deduplicate by symmetry class (stores canonical orientations)\n"
+            "  -M       inputs are already sorted: merge them without a run phase\n"
+            "  -T DIR   directory for temporary run files (default .)\n");
+    }
+
+    std::string runPath(const Options& options, size_t index) {
+        return options.tempDir + "/othello_posdb." + std::to_string((long)getpid()) +
+               "." + std::to_string(index) + ".run";
+    }
+
+    bool writeSorted(std::vector<PackedBoard>& chunk, const char* path, size_t bufferRecords, uint64_t& written) {
+        std::sort(chunk.begin(), chunk.end());
+        chunk.erase(std::unique(chunk.begin(), chunk.end()), chunk.end());
+        PositionWriter writer;
+        if(!writer.open(path, bufferRecords)) return false;
+        for(const PackedBoard& position : chunk) writer.write(position);
+        written = writer.count();
+        return writer.close();
+    }
+
+    // Records per I/O buffer when `files` open files share budgetBytes
+    size_t bufferRecords(size_t budgetBytes, size_t files) {
+        size_t records = budgetBytes / files / PositionFile::RecordSize;
+        return std::max(MinBufferRecords, std::min(PositionFile::DefaultBufferRecords, records));
+    }
+
+    // K-way merge of sorted files into one sorted, duplicate-free file; the
+    // readers' and the writer's buffers together stay within budgetBytes
+    bool mergeFiles(const std::vector<std::string>& inputs, const char* path, size_t budgetBytes, uint64_t& written) {
+        size_t records = bufferRecords(budgetBytes, inputs.size() + 1);
+        std::vector<PositionReader> readers(inputs.size());
+        std::priority_queue<MergeHead, std::vector<MergeHead>, std::greater<MergeHead> > heap;
+        for(size_t i = 0; i < inputs.size(); ++i) {
+            if(!readers[i].open(inputs[i].c_str(), records)) {
+                fprintf(stderr, "othello_posdb: cannot read %s\n", inputs[i].c_str());
+                return false;
+            }
+            MergeHead head;
+            head.source = i;
+            if(readers[i].next(head.position)) heap.push(head);
+        }
+
+        PositionWriter writer;
+        if(!writer.open(path, records)) {
+            fprintf(stderr, "othello_posdb: cannot write %s\n", path);
+            return false;
+        }
+        bool haveLast = false;
+        PackedBoard last = PackedBoard();
+        while(!heap.empty()) {
+            MergeHead head = heap.top();
+            heap.pop();
+            if(!haveLast || head.position != last) {
+                writer.write(head.position);
+                last = head.position;
+                haveLast = true;
+            }
+            if(readers[head.source].next(head.position)) heap.push(head);
+        }
+        written = writer.count();
+
+        for(size_t i = 0; i < readers.size(); ++i) {
+            if(readers[i].error()) {
+                fprintf(stderr, "othello_posdb: read error in %s\n", inputs[i].c_str());
+                return false;
+            }
+        }
+        return writer.close();
+    }
+
+    void removeFiles(const std::vector<std::string>& paths) {
+        for(const std::string& path : paths) remove(path.c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int opt;
+    while((opt = getopt(argc, argv, "o:m:sMT:h")) != -1) {
+        switch(opt) {
+            case 'o': options.output = optarg; break;
+            case 'm': options.memoryMB = std::max(1L, atol(optarg)); break;
+            case 's': options.symmetry = true; break;
+            case 'M': options.presorted = true; break;
+            case 'T': options.tempDir = optarg; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+    for(int i = optind; i < argc; ++i) options.inputs.push_back(argv[i]);
+    if(!options.output || options.inputs.empty()) {
+        usage();
+        return 1;
+    }
+    if(options.presorted && options.symmetry) {
+        fprintf(stderr, "othello_posdb: -s reorders records and cannot be combined with -M\n");
+        return 1;
+    }
+
+    Zobrist::init();
+    size_t budgetBytes = options.memoryMB * 1024 * 1024;
+    uint64_t read = 0, written = 0;
+    size_t nextRun = 0;
+    std::vector<std::string> runs;      // Temporary files we own
+    std::vector<std::string> sources;   // Sorted files for the merge phase
+
+    if(options.presorted) {
+        for(const char* input : options.inputs) sources.push_back(input);
+    } else {
+        // Run phase: fill memory, sort, write a run, repeat. The chunk gets
+        // what the input and run file buffers leave of the budget.
+        size_t ioRecords = bufferRecords(budgetBytes / RunBufferShare, 1);
+        size_t chunkRecords = (budgetBytes - 2 * ioRecords * PositionFile::RecordSize) / sizeof(PackedBoard);
+        std::vector<PackedBoard> chunk;
+        chunk.reserve(chunkRecords);
+        for(const char* input : options.inputs) {
+            PositionReader reader;
+            if(!reader.open(input, ioRecords)) {
+                fprintf(stderr, "othello_posdb: cannot read %s\n", input);
+                removeFiles(runs);
+                return 1;
+            }
+            PackedBoard position;
+            while(reader.next(position)) {
+                ++read;
+                chunk.push_back(options.symmetry ? position.canonical() : position);
+                if(chunk.size() == chunkRecords) {
+                    runs.push_back(runPath(options, nextRun++));
+                    uint64_t runCount;
+                    if(!writeSorted(chunk, runs.back().c_str(), ioRecords, runCount)) {
+                        fprintf(stderr, "othello_posdb: cannot write %s\n", runs.back().c_str());
+                        removeFiles(runs);
+                        return 1;
+                    }
+                    chunk.clear();
+                }
+            }
+            if(reader.error()) {
+                fprintf(stderr, "othello_posdb: read error in %s\n", input);
+                removeFiles(runs);
+                return 1;
+            }
+        }
+
+        if(runs.empty()) {
+            // Everything fit in memory: no merge needed
+            if(!writeSorted(chunk, options.output, ioRecords, written)) {
+                fprintf(stderr, "othello_posdb: cannot write %s\n", options.output);
+                return 1;
+            }
+            fprintf(stderr, "othello_posdb: %llu positions read, %llu written\n",
+                    (unsigned long long)read, (unsigned long long)written);
+            return 0;
+        }
+        if(!chunk.empty()) {
+            runs.push_back(runPath(options, nextRun++));
+            uint64_t runCount;
+            if(!writeSorted(chunk, runs.back().c_str(), ioRecords, runCount)) {
+                fprintf(stderr, "othello_posdb: cannot write %s\n", runs.back().c_str());
+                removeFiles(runs);
+                return 1;
+            }
+        }
+        std::vector<PackedBoard>().swap(chunk);
+        sources = runs;
+    }
+
+    // Merge phase: reduce fan-in with intermediate passes if there are many runs
+    size_t runCount = sources.size();
+    while(sources.size() > MaxMergeFanIn) {
+        std::vector<std::string> merged;
+        for(size_t start = 0; start < sources.size(); start += MaxMergeFanIn) {
+            size_t end = std::min(sources.size(), start + MaxMergeFanIn);
+            std::vector<std::string> group(sources.begin() + start, sources.begin() + end);
+            merged.push_back(runPath(options, nextRun++));
+            runs.push_back(merged.back());
+            uint64_t mergedCount;
+            if(!mergeFiles(group, merged.back().c_str(), budgetBytes, mergedCount)) {
+                removeFiles(runs);
+                return 1;
+            }
+        }
+        sources.swap(merged);
+    }
+    bool ok = mergeFiles(sources, options.output, budgetBytes, written);
+    removeFiles(runs);
+    if(!ok) return 1;
+
+    if(options.presorted) {
+        fprintf(stderr, "othello_posdb: %zu files merged, %llu positions written\n",
+                runCount, (unsigned long long)written);
+    } else {
+        fprintf(stderr, "othello_posdb: %llu positions read in %zu runs, %llu written\n",
+                (unsigned long long)read, runCount, (unsigned long long)written);
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+// Serve many games from one process over a line protocol on stdin/stdout.
+// Each game is a session with its own budgets; searches share one
+// work-stealing thread pool and run concurrently. Replies to a command are
+// printed immediately, search results whenever they finish, so clients
+// match them by session id. To serve a local socket, run it behind e.g.
+// socat UNIX-LISTEN:/tmp/othello.sock,fork EXEC:./othello_server.
+//
+//   new [tt=MB] [time=MS] [depth=N] [nodes=N] [cache=BITS]  -> session ID
+//       tt: transposition table size, at least 1, rounded down to a power of two
+//   position ID start | position ID BOARD black|white         -> ok ID
+//       BOARD: 64 characters X (black), O (white) or - (empty), a1..h1 first
+//   play ID SQUARE (e.g. f5)                                  -> ok ID
+//   moves ID                                                  -> moves ID SQUARE...
+//   show ID                                                   -> board ID BOARD SIDE
+//   go ID    -> ok ID, later: bestmove ID SQUARE|pass nodes N time MS [cancelled]
+//   stop ID | close ID                                        -> ok ID
+//   sessions                                                  -> sessions COUNT
+//   quit
+// Failures print "error [ID] reason".
+#include "session.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    std::mutex outputMutex;
+
+    // Commands and search threads both reply; keep lines whole
+    void reply(const char* format, ...) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        putchar('\n');
+        fflush(stdout);
+    }
+
+    std::string squareName(int square) {
+        std::string name;
+        name += (char)('a' + square % 10 - 1);
+        name += (char)('0' + square / 10);
+        return name;
+    }
+
+    int parseSquare(const std::string& name) {
+        if(name.size() != 2) return -1;
+        int col = tolower(name[0]) - 'a' + 1;
+        int row = name[1] - '0';
+        if(col < 1 || col > 8 || row < 1 || row > 8) return -1;
+        return row * 10 + col;
+    }
+
+    bool parseBoard(const std::string& text, uint64_t& black, uint64_t& white) {
+        if(text.size() != 64) return false;
+        black = white = 0;
+        for(int bit = 0; bit < 64; ++bit) {
+            char c = (char)toupper(text[bit]);
+            if(c == 'X') black |= 1ULL << bit;
+            else if(c == 'O') white |= 1ULL << bit;
+            else if(c != '-' && c != '.') return false;
+        }
+        return true;
+    }
+
+    // key=value options of "new" over the server defaults
+    bool parseOptions(std::istringstream& in, SessionOptions& options) {
+        std::string token;
+        while(in >> token) {
+            size_t eq = token.find('=');
+            if(eq == std::string::npos) return false;
+            std::string key = token.substr(0, eq);
+            long long value = atoll(token.c_str() + eq + 1);
+            if(value < 0) return false;
+            if(key == "tt" && value > 0) options.ttMegabytes = (size_t)value; // tt=0 falls through to an error
+            else if(key == "time") options.timeMs = (int)value;
+            else if(key == "depth") options.maxDepth = (int)value;
+            else if(key == "nodes") options.maxNodes = (uint64_t)value;
+            else if(key == "cache") options.evalCacheBits = std::min(24, std::max(1, (int)value));
+            else return false;
+        }
+        return true;
+    }
+
+    void reportSearch(const SearchReport& report) {
+        reply("bestmove %d %s nodes %llu time %d%s", report.session,
+              report.move == -1 ? "pass" : squareName(report.move).c_str(),
+              (unsigned long long)report.nodes, report.elapsedMs, report.cancelled ? " cancelled" : "");
+    }
+
+    // One command line; false on quit
+    bool handle(SessionEngine& server, const SessionOptions& defaults, const std::string& line) {
+        std::istringstream in(line);
+        std::string command;
+        if(!(in >> command)) return true;
+        if(command == "quit") return false;
+        if(command == "new") {
+            SessionOptions options = defaults;
+            if(!parseOptions(in, options)) reply("error bad option");
+            else reply("session %d", server.open(options));
+            return true;
+        }
+        if(command == "sessions") {
+            reply("sessions %zu", server.sessionCount());
+            return true;
+        }
+
+        int id = 0;
+        if(!(in >> id)) {
+            reply("error unknown command or missing session id");
+            return true;
+        }
+        std::shared_ptr<Session> session = server.find(id);
+        if(!session) {
+            reply("error %d no such session", id);
+            return true;
+        }
+
+        if(command == "position") {
+            std::string text, side;
+            in >> text >> side;
+            uint64_t black, white;
+            bool ok;
+            if(text == "start") ok = session->newGame();
+            else ok = parseBoard(text, black, white) && (side == "black" || side == "white") &&
+                      session->setPosition(black, white, side == "black" ? OthelloBoard::BLACK : OthelloBoard::WHITE);
+            if(ok) reply("ok %d", id);
+            else reply("error %d bad position or busy", id);
+        } else if(command == "play") {
+            std::string square;
+            in >> square;
+            if(session->play(parseSquare(square))) reply("ok %d", id);
+            else reply("error %d illegal move or busy", id);
+        } else if(command == "moves") {
+            std::vector<int> moves;
+            if(!session->legalMoves(moves)) {
+                reply("error %d busy", id);
+                return true;
+            }
+            std::string list;
+            for(int move : moves) list += " " + squareName(move);
+            reply("moves %d%s", id, list.c_str());
+        } else if(command == "show") {
+            uint64_t black, white;
+            int player;
+            if(!session->snapshot(black, white, player)) {
+                reply("error %d busy", id);
+                return true;
+            }
+            std::string text(64, '-');
+            for(int bit = 0; bit < 64; ++bit) {
+                if(black >> bit & 1) text[bit] = 'X';
+                else if(white >> bit & 1) text[bit] = 'O';
+            }
+            reply("board %d %s %s", id, text.c_str(), player == OthelloBoard::BLACK ? "black" : "white");
+        } else if(command == "go") {
+            if(server.go(id, reportSearch)) reply("ok %d", id);
+            else reply("error %d busy", id);
+        } else if(command == "stop") {
+            server.stop(id);
+            reply("ok %d", id);
+        } else if(command == "close") {
+            server.close(id);
+            reply("ok %d", id);
+        } else {
+            reply("error %d unknown command %s", id, command.c_str());
+        }
+        return true;
+    }
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_server [options]\n"
+            "  -j N      search threads shared by all sessions (default: all cores)\n"
+            "  -t MS     default time per search (default 1000, 0 = no limit)\n"
+            "  -d DEPTH  default maximum depth (default 20)\n"
+            "  -m MB     default transposition table size per session, at least 1,\n"
+            "            rounded down to a power of two (default 16)\n"
+            "  -W FILE   NNUE weights shared by all sessions\n"
+            "Reads commands from stdin; see the top of othello_server.cpp.\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    SessionOptions defaults;
+    int threads = 0;
+    const char* weights = nullptr;
+    int opt;
+    while((opt = getopt(argc, argv, "j:t:d:m:W:h")) != -1) {
+        switch(opt) {
+            case 'j': threads = atoi(optarg); break;
+            case 't': defaults.timeMs = std::max(0, atoi(optarg)); break;
+            case 'd': defaults.maxDepth = std::max(1, atoi(optarg)); break;
+            case 'm': defaults.ttMegabytes = (size_t)std::max(0, atoi(optarg)); break;
+            case 'W': weights = optarg; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if(defaults.ttMegabytes == 0) {
+        fprintf(stderr, "othello_server: -m needs at least 1 MB\n");
+        return 1;
+    }
+
+    Zobrist::init(); // Before any session builds a board
+    SessionEngine server(threads);
+    if(weights && !server.loadNetwork(weights)) {
+        fprintf(stderr, "othello_server: cannot load network %s\n", weights);
+        return 1;
+    }
+    std::string line;
+    while(std::getline(std::cin, line) && handle(server, defaults, line)) {}
+
+    // Cancel whatever is still searching; the pool drains before exit
+    for(int id = 1; server.sessionCount() > 0; ++id) server.close(id);
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Import WTHOR game databases (.wtb) into an opening index: for every
+// position reached (keyed by symmetry class) the number of games, the score
+// for the side to move and statistics for each next move. Files are mapped
+// with mmap and games are replayed on bitboards on all cores without
+// per-game allocation; -q queries an index.
+#include "othello_board.h"
+#include "opening_index.h"
+#include "wthor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+    struct Options {
+        const char* index = "openings.idx";
+        const char* query = nullptr;
+        int threads = 0;
+        int maxPlies = Wthor::MaxMoves;
+        std::vector<const char*> inputs;
+    };
+
+    int runImport(const Options& options) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<WthorFile>> files;
+        std::vector<const WthorFile*> games;
+        for(const char* input : options.inputs) {
+            std::unique_ptr<WthorFile> file(new WthorFile());
+            if(!file->open(input)) {
+                fprintf(stderr, "othello_wthor: cannot read %s as a WTHOR database\n", input);
+                return 1;
+            }
+            games.push_back(file.get());
+            files.push_back(std::move(file));
+        }
+
+        ImportStats stats;
+        std::vector<OpeningRecord> records = importGames(games, options.threads, options.maxPlies, stats);
+        uint64_t positions = 0;
+        for(const OpeningRecord& record : records) positions += record.move == 0;
+
+        if(!writeOpeningIndex(options.index, records)) {
+            fprintf(stderr, "othello_wthor: cannot write %s\n", options.index);
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "othello_wthor: %llu games (%llu rejected), %llu positions, %zu records -> %s "
+                "in %.2fs on %d threads\n", (unsigned long long)stats.games, (unsigned long long)stats.badGames,
+                (unsigned long long)positions, records.size(), options.index, seconds, stats.threads);
+        return 0;
+    }
+
+    std::string squareName(int square) {
+        std::string name;
+        name += (char)('a' + square % 10 - 1);
+        name += (char)('0' + square / 10);
+        return name;
+    }
+
+    // Plays moves like "f5d6c3" from the standard start position
+    bool playMoves(const char* moves, uint64_t discs[3], int& player) {
+        Wthor::startPosition(discs);
+        player = OthelloBoard::BLACK;
+        for(const char* p = moves; p[0] && p[1]; p += 2) {
+            int col = p[0] >= 'A' && p[0] <= 'H' ? p[0] - 'A' + 1 : p[0] - 'a' + 1;
+            if(col < 1 || col > 8 || p[1] < '1' || p[1] > '8') return false;
+            if(!Wthor::playMove(discs, player, (p[1] - '0') * 10 + col)) return false;
+        }
+        if(strlen(moves) % 2) return false;
+        player = Wthor::playerToMove(discs, player);
+        return true;
+    }
+
+    int runQuery(const Options& options) {
+        OpeningIndex index;
+        if(!index.open(options.index)) {
+            fprintf(stderr, "othello_wthor: cannot read index %s\n", options.index);
+            return 1;
+        }
+        uint64_t discs[3];
+        int player;
+        if(!playMoves(options.query, discs, player)) {
+            fprintf(stderr, "othello_wthor: illegal move sequence %s\n", options.query);
+            return 1;
+        }
+        int sym;
+        uint64_t key = Symmetry::canonicalKey(discs[OthelloBoard::BLACK], discs[OthelloBoard::WHITE], player, sym);
+        std::vector<OpeningRecord> records;
+        if(!index.lookup(key, records) || records[0].move != 0) {
+            printf("position not in index\n");
+            return 0;
+        }
+        const OpeningRecord& total = records[0];
+        printf("%u games, %s to move, score %.1f%%\n", total.games,
+               player == OthelloBoard::BLACK ? "black" : "white", 100.0 * total.winRate());
+        std::sort(records.begin() + 1, records.end(), [](const OpeningRecord& a, const OpeningRecord& b) {
+            return a.games > b.games;
+        });
+        for(size_t i = 1; i < records.size(); ++i) {
+            printf("  %s  games %8u  played %5.1f%%  score %5.1f%%\n",
+                   squareName(Symmetry::inverseSquare(records[i].move, sym)).c_str(), records[i].games,
+                   100.0 * records[i].games / total.games, 100.0 * records[i].winRate());
+        }
+        return 0;
+    }
+
+    void usage() {
+        fprintf(stderr,
+            "Usage: othello_wthor [options] FILE.wtb...\n"
+            "       othello_wthor [-i INDEX] -q MOVES\n"
+            "  -i FILE   opening index to write or query (default openings.idx)\n"
+            "  -j N      worker threads (default: all cores)\n"
+            "  -p PLIES  index positions up to this many moves into the game (default 60)\n"
+            "  -q MOVES  print index statistics for the position after MOVES (e.g. f5d6c3)\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    int opt;
+    while((opt = getopt(argc, argv, "i:j:p:q:h")) != -1) {
+        switch(opt) {
+            case 'i': options.index = optarg; break;
+            case 'j': options.threads = atoi(optarg); break;
+            case 'p': options.maxPlies = std::min(Wthor::MaxMoves, std::max(0, atoi(optarg))); break;
+            case 'q': options.query = optarg; break;
+            default: usage(); return opt == 'h' ? 0 : 1;
+        }
+    }
+    for(int i = optind; i < argc; ++i) options.inputs.push_back(argv[i]);
+    if(options.query ? !options.inputs.empty() : options.inputs.empty()) {
+        usage();
+        return 1;
+    }
+
+    Zobrist::init(); // Before any worker thread builds a board
+    return options.query ? runQuery(options) : runImport(options);
+}
@@ -0,0 +1,220 @@
+#include "parallel_solver.h"
+#include <mutex>
+#include <thread>
+
+namespace {
+    const uint64_t FlushNodes = 256; // Nodes counted per thread before the shared count and budget checks
+
+    // Nodes this thread searched and has not yet added to the job's total
+    thread_local uint64_t localNodes = 0;
+
+    // Slot data: value + 128 (8 bits), empties (8), move bit + 1 (8), flag (2)
+    uint64_t packSlot(int value, int empties, int move, TTEntry::Flag flag) {
+        return (uint64_t)(value + 128) | (uint64_t)empties << 8 | (uint64_t)(move + 1) << 16 | (uint64_t)flag << 24;
+    }
+}
+
+// Shared state of one solve
+struct ParallelSolver::Job {
+    bool wld;
+    const TimeManager& budget;
+    std::atomic<uint64_t> nodes;
+    std::atomic<bool> stop; // Budget exhausted: every thread unwinds
+
+    Job(bool w, const TimeManager& b) : wld(w), budget(b), nodes(0), stop(false) {}
+
+    void flushNodes() {
+        uint64_t total = nodes.fetch_add(localNodes) + localNodes;
+        localNodes = 0;
+        uint64_t limit = budget.getNodeLimit();
+        if((limit && total >= limit) || budget.stopRequested() || budget.timeUp()) stop = true;
+    }
+
+    void countNode() {
+        if(++localNodes >= FlushNodes) flushNodes();
+    }
+};
+
+// Children of one node being searched in parallel. alpha and the best result
+// are guarded by mutex; cutoff is set once a child fails high.
+struct ParallelSolver::SplitPoint {
+    const SplitPoint* parent;
+    int alpha;
+    int beta;
+    int bestVal;
+    int bestBit;
+    std::mutex mutex;
+    std::atomic<int> pending;
+    std::atomic<bool> cutoff;
+
+    SplitPoint(const SplitPoint* p, int a, int b, int val, int bit)
+        : parent(p), alpha(a), beta(b), bestVal(val), bestBit(bit), pending(0), cutoff(false) {}
+
+    // True once this or any enclosing split point has cut off
+    bool aborted() const {
+        for(const SplitPoint* point = this; point; point = point->parent) {
+            if(point->cutoff.load(std::memory_order_relaxed)) return true;
+        }
+        return false;
+    }
+};
+
+ParallelSolver::ParallelSolver(int threads, int tableBits) : table(size_t(1) << tableBits) {
+    threadCount = threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency());
+    if(threadCount > 1) pool.reset(new ThreadPool(threadCount - 1));
+    mask = table.size() - 1;
+    clear();
+}
+
+void ParallelSolver::clear() {
+    for(Slot& slot : table) {
+        slot.check.store(0, std::memory_order_relaxed);
+        slot.data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool ParallelSolver::probe(uint64_t key, int empties, int alpha, int beta, int& value, int& move) const {
+    const Slot& slot = table[key & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    if((slot.check.load(std::memory_order_relaxed) ^ data) != key || data == 0) return false;
+    move = (int)(data >> 16 & 0xff) - 1;
+    if((int)(data >> 8 & 0xff) < empties) return false;
+    int stored = (int)(data & 0xff) - 128;
+    TTEntry::Flag flag = (TTEntry::Flag)(data >> 24 & 3);
+    if(flag == TTEntry::EXACT || (flag == TTEntry::LOWER_BOUND && stored >= beta) ||
+       (flag == TTEntry::UPPER_BOUND && stored <= alpha)) {
+        value = stored;
+        return true;
+    }
+    return false;
+}
+
+void ParallelSolver::store(uint64_t key, int value, int empties, int move, TTEntry::Flag flag) {
+    Slot& slot = table[key & mask];
+    uint64_t data = packSlot(value, empties, move, flag);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+// OthelloEngine::solveEndgame with the eldest child searched first and the
+// younger ones split over the pool at nodes with SplitMinEmpties or more
+int ParallelSolver::search(Job& job, uint64_t P, uint64_t O, int alpha, int beta, bool passed,
+                           const SplitPoint* parent, int* bestBitOut) {
+    job.countNode();
+    int empties = 64 - Bitboard::popcount(P | O);
+    bool pollAborts = parent && empties >= AbortCheckEmpties;
+    if(job.stop.load(std::memory_order_relaxed) || (pollAborts && parent->aborted())) return alpha;
+
+    uint64_t moves = Bitboard::legalMoves(P, O);
+    if(!moves) {
+        if(passed) return OthelloEngine::finalScore(P, O, job.wld);
+        return -search(job, O, P, -beta, -alpha, true, parent, nullptr);
+    }
+
+    int originalAlpha = alpha;
+    uint64_t key = 0;
+    int ttMove = -1;
+    if(empties >= SolveTTMinEmpties) {
+        key = Bitboard::hash(P, O) ^ SolveKeySalt[job.wld];
+        int ttValue;
+        if(probe(key, empties, alpha, beta, ttValue, ttMove)) {
+            if(bestBitOut) *bestBitOut = ttMove;
+            return ttValue;
+        }
+    }
+
+    // Order: TT move, then fastest-first (fewest opponent replies)
+    int order[64];
+    int count = 0;
+    for(uint64_t bits = moves; bits; bits &= bits - 1) order[count++] = __builtin_ctzll(bits);
+    if(empties > SolveOrderMinEmpties) {
+        int replies[64];
+        for(int i = 0; i < count; ++i) {
+            int bit = order[i];
+            uint64_t f = Bitboard::flips(P, O, bit);
+            replies[bit] = (bit == ttMove) ? -1 :
+                Bitboard::popcount(Bitboard::legalMoves(O & ~f, P | f | (1ULL << bit)));
+        }
+        std::sort(order, order + count, [&replies](int a, int b) { return replies[a] < replies[b]; });
+    }
+
+    bool split = pool && empties >= SplitMinEmpties && count > 1;
+    int bestVal = INT_MIN;
+    int bestBit = -1;
+    for(int i = 0; i < (split ? 1 : count); ++i) {
+        int bit = order[i];
+        uint64_t f = Bitboard::flips(P, O, bit);
+        int val = -search(job, O & ~f, P | f | (1ULL << bit), -beta, -alpha, false, parent, nullptr);
+        if(job.stop.load(std::memory_order_relaxed) || (pollAborts && parent->aborted())) return alpha;
+        if(val > bestVal) {
+            bestVal = val;
+            bestBit = bit;
+            if(val > alpha) alpha = val;
+            if(alpha >= beta) break;
+        }
+    }
+
+    if(split && alpha < beta) {
+        SplitPoint point(parent, alpha, beta, bestVal, bestBit);
+        searchSiblings(job, point, P, O, order + 1, count - 1);
+        if(job.stop.load(std::memory_order_relaxed) || (parent && parent->aborted())) return alpha;
+        bestVal = point.bestVal;
+        bestBit = point.bestBit;
+    }
+
+    if(key) {
+        TTEntry::Flag flag = TTEntry::boundFor(bestVal, originalAlpha, beta);
+        if(job.wld && bestVal != 0) flag = TTEntry::EXACT;
+        store(key, bestVal, empties, bestBit, flag);
+    }
+    if(bestBitOut) *bestBitOut = bestBit;
+    return bestVal;
+}
+
+// Queues the younger brothers and helps run pool tasks until all of them
+// have finished or been skipped after a cutoff
+void ParallelSolver::searchSiblings(Job& job, SplitPoint& point, uint64_t P, uint64_t O, const int* bits, int count) {
+    point.pending = count;
+    for(int i = 0; i < count; ++i) {
+        int bit = bits[i];
+        pool->submit([this, &job, &point, P, O, bit]() {
+            if(!job.stop.load(std::memory_order_relaxed) && !point.aborted()) {
+                int alpha;
+                {
+                    std::lock_guard<std::mutex> lock(point.mutex);
+                    alpha = point.alpha;
+                }
+                uint64_t f = Bitboard::flips(P, O, bit);
+                int val = -search(job, O & ~f, P | f | (1ULL << bit), -point.beta, -alpha, false, &point, nullptr);
+                if(!job.stop.load(std::memory_order_relaxed) && !point.aborted()) {
+                    std::lock_guard<std::mutex> lock(point.mutex);
+                    if(val > point.bestVal) {
+                        point.bestVal = val;
+                        point.bestBit = bit;
+                        if(val > point.alpha) point.alpha = val;
+                        if(point.alpha >= point.beta) point.cutoff = true;
+                    }
+                }
+            }
+            job.flushNodes();
+            point.pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    while(point.pending.load(std::memory_order_acquire) > 0) {
+        if(!pool->runOne()) std::this_thread::yield();
+    }
+}
+
+SolveResult ParallelSolver::solve(uint64_t P, uint64_t O, bool wld, const TimeManager& budget, SearchStats& stats) {
+    Job job(wld, budget);
+    int bit = -1;
+    int score = search(job, P, O, wld ? -1 : -64, wld ? 1 : 64, false, nullptr, &bit);
+    job.flushNodes();
+    stats.solveNodes = job.nodes;
+    SolveResult result = {0, -1, false};
+    if(job.stop) return result;
+    result.score = score;
+    result.move = bit >= 0 ? Bitboard::bitToSquare(bit) : -1;
+    result.complete = true;
+    return result;
+}
@@ -0,0 +1,51 @@
+#ifndef PARALLEL_SOLVER_H
+#define PARALLEL_SOLVER_H
+
+#include "othello_engine.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Endgame solver that splits the tree over a work-stealing ThreadPool with
+// Young Brothers Wait: a node searches its first (best-ordered) child alone,
+// then, if that did not cut off, hands the remaining children to the pool as
+// tasks on copies of the bitboards and helps run queued tasks until they are
+// done. A cutoff at a split point aborts the siblings still running there
+// and everything split below them. All threads share one lockless hash
+// table, and the solver keeps it between solves.
+class ParallelSolver : public EndgameSolver {
+public:
+    static const int SplitMinEmpties = 12;   // Smaller subtrees are searched serially
+    static const int AbortCheckEmpties = 7;  // Smaller subtrees finish instead of polling for aborts
+
+    // threads <= 0 uses every core (the caller of solve is one of them); the
+    // table has 2^tableBits slots of 16 bytes
+    explicit ParallelSolver(int threads = 0, int tableBits = 20);
+
+    SolveResult solve(uint64_t P, uint64_t O, bool wld, const TimeManager& budget, SearchStats& stats) override;
+
+    int threads() const { return threadCount; }
+    void clear();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check; // key ^ data, so torn writes never match
+        std::atomic<uint64_t> data;
+    };
+    struct Job;
+    struct SplitPoint;
+
+    int threadCount;
+    std::unique_ptr<ThreadPool> pool; // threads - 1 helpers, none when single-threaded
+    std::vector<Slot> table;
+    uint64_t mask;
+
+    int search(Job& job, uint64_t P, uint64_t O, int alpha, int beta, bool passed,
+               const SplitPoint* parent, int* bestBitOut);
+    void searchSiblings(Job& job, SplitPoint& point, uint64_t P, uint64_t O, const int* bits, int count);
+    bool probe(uint64_t key, int empties, int alpha, int beta, int& value, int& move) const;
+    void store(uint64_t key, int value, int empties, int move, TTEntry::Flag flag);
+};
+
+#endif // PARALLEL_SOLVER_H
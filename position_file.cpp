@@ -0,0 +1,92 @@
+#include "position_file.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    void encodeWord(unsigned char* out, uint64_t value) {
+        for(int i = 0; i < 8; ++i) out[i] = (unsigned char)(value >> (8 * i));
+    }
+
+    uint64_t decodeWord(const unsigned char* in) {
+        uint64_t value = 0;
+        for(int i = 0; i < 8; ++i) value |= (uint64_t)in[i] << (8 * i);
+        return value;
+    }
+}
+
+bool PositionWriter::open(const char* path, size_t bufferRecords) {
+    close();
+    file = fopen(path, "wb");
+    if(!file) return false;
+    buffer.resize(std::max<size_t>(bufferRecords, 1) * PositionFile::RecordSize);
+    used = 0;
+    written = 0;
+    failed = fwrite(PositionFile::Magic, 1, sizeof(PositionFile::Magic), file) != sizeof(PositionFile::Magic);
+    return !failed;
+}
+
+bool PositionWriter::flush() {
+    if(used && fwrite(buffer.data(), 1, used, file) != used) failed = true;
+    used = 0;
+    return !failed;
+}
+
+bool PositionWriter::write(const PackedBoard& position) {
+    if(!file || failed) return false;
+    if(used == buffer.size() && !flush()) return false;
+    encodeWord(&buffer[used], position.black);
+    encodeWord(&buffer[used + 8], position.white);
+    used += PositionFile::RecordSize;
+    ++written;
+    return true;
+}
+
+bool PositionWriter::close() {
+    if(!file) return !failed;
+    flush();
+    if(fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+bool PositionReader::open(const char* path, size_t bufferRecords) {
+    close();
+    failed = false;
+    file = fopen(path, "rb");
+    if(!file) return false;
+    char magic[sizeof(PositionFile::Magic)];
+    if(fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+       memcmp(magic, PositionFile::Magic, sizeof(magic)) != 0) {
+        failed = true;
+        close();
+        return false;
+    }
+    buffer.resize(std::max<size_t>(bufferRecords, 1) * PositionFile::RecordSize);
+    used = filled = 0;
+    return true;
+}
+
+bool PositionReader::next(PackedBoard& position) {
+    if(!file) return false;
+    if(used == filled) {
+        filled = fread(buffer.data(), 1, buffer.size(), file);
+        used = 0;
+        if(filled % PositionFile::RecordSize != 0) {
+            failed = true; // Truncated record
+            filled -= filled % PositionFile::RecordSize;
+        }
+        if(filled == 0) {
+            if(ferror(file)) failed = true;
+            return false;
+        }
+    }
+    position.black = decodeWord(&buffer[used]);
+    position.white = decodeWord(&buffer[used + 8]);
+    used += PositionFile::RecordSize;
+    return true;
+}
+
+void PositionReader::close() {
+    if(file) fclose(file);
+    file = nullptr;
+}
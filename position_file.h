@@ -0,0 +1,60 @@
+#ifndef POSITION_FILE_H
+#define POSITION_FILE_H
+
+#include "othello_board.h"
+#include <cstdio>
+#include <vector>
+
+// Streaming position files: an 8-byte magic followed by PackedBoard records,
+// each stored as two little-endian 64-bit words (black, white).
+namespace PositionFile {
+    const char Magic[8] = {'O', 'T', 'H', 'P', 'O', 'S', '0', '1'};
+    const size_t RecordSize = 16;
+    const size_t DefaultBufferRecords = 1 << 16; // 1 MiB of I/O buffer per open file
+}
+
+class PositionWriter {
+private:
+    FILE* file;
+    std::vector<unsigned char> buffer;
+    size_t used;
+    uint64_t written;
+    bool failed;
+
+    bool flush();
+
+public:
+    PositionWriter() : file(nullptr), used(0), written(0), failed(false) {}
+    ~PositionWriter() { close(); }
+    PositionWriter(const PositionWriter&) = delete;
+    PositionWriter& operator=(const PositionWriter&) = delete;
+
+    bool open(const char* path, size_t bufferRecords = PositionFile::DefaultBufferRecords);
+    bool write(const PackedBoard& position);
+    bool close();
+
+    uint64_t count() const { return written; }
+};
+
+class PositionReader {
+private:
+    FILE* file;
+    std::vector<unsigned char> buffer;
+    size_t used;
+    size_t filled;
+    bool failed;
+
+public:
+    PositionReader() : file(nullptr), used(0), filled(0), failed(false) {}
+    ~PositionReader() { close(); }
+    PositionReader(const PositionReader&) = delete;
+    PositionReader& operator=(const PositionReader&) = delete;
+
+    bool open(const char* path, size_t bufferRecords = PositionFile::DefaultBufferRecords);
+    bool next(PackedBoard& position); // false at end of file or on error
+    void close();
+
+    bool error() const { return failed; }
+};
+
+#endif // POSITION_FILE_H
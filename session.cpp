@@ -0,0 +1,149 @@
+#include "session.h"
+
+Session::Session(int id, const SessionOptions& opts, std::shared_ptr<const Nnue::Network> network)
+    : sessionId(id), options(opts), player(OthelloBoard::BLACK), busy(false), stopFlag(false) {
+    if(options.ttMegabytes) engine.transTable.setCapacity(options.ttMegabytes * 1024 * 1024 / TTBytesPerEntry);
+    engine.evalCache.resize(options.evalCacheBits);
+    engine.timeManager.enableTimeLimit(options.timeMs > 0);
+    if(options.timeMs > 0) engine.timeManager.setTimeLimit(options.timeMs);
+    engine.timeManager.setNodeLimit(options.maxNodes);
+    engine.timeManager.setStopFlag(&stopFlag);
+    if(network) engine.setNetwork(network);
+    engine.board.initBoard();
+}
+
+bool Session::newGame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(busy) return false;
+    engine.board.initBoard();
+    player = OthelloBoard::BLACK;
+    return true;
+}
+
+bool Session::setPosition(uint64_t black, uint64_t white, int toMove) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(busy || (black & white) || (toMove != OthelloBoard::BLACK && toMove != OthelloBoard::WHITE)) return false;
+    engine.board.setPosition(black, white);
+    player = toMove;
+    passIfStuck();
+    return true;
+}
+
+bool Session::play(int move) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(busy || move < 11 || move > 88 || !engine.board.legalMove(move, player)) return false;
+    engine.board.makeMove(move, player);
+    player = engine.board.opponent(player);
+    passIfStuck();
+    return true;
+}
+
+void Session::passIfStuck() {
+    int other = engine.board.opponent(player);
+    if(!engine.board.hasLegalMoves(player) && engine.board.hasLegalMoves(other)) player = other;
+}
+
+bool Session::snapshot(uint64_t& black, uint64_t& white, int& toMove) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(busy) return false;
+    black = engine.board.bitboard(OthelloBoard::BLACK);
+    white = engine.board.bitboard(OthelloBoard::WHITE);
+    toMove = player;
+    return true;
+}
+
+bool Session::legalMoves(std::vector<int>& moves) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(busy) return false;
+    moves.clear();
+    for(int i = 11; i <= 88; ++i) {
+        if(i % 10 != 0 && i % 10 != 9 && engine.board.legalMove(i, player)) moves.push_back(i);
+    }
+    return true;
+}
+
+bool Session::searching() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return busy;
+}
+
+// Runs with busy set, so no other call touches the engine meanwhile
+SearchReport Session::search() {
+    SearchReport report = {sessionId, -1, 0, 0, false};
+    if(stopFlag) {
+        report.cancelled = true; // Cancelled while still queued
+    } else if(engine.board.hasLegalMoves(player)) {
+        int move = engine.chooseMove(player, std::max(1, options.maxDepth));
+        for(int i = 11; i <= 88 && move == -1; ++i) {
+            if(engine.board.legalMove(i, player)) move = i; // Stopped before depth 1 finished
+        }
+        report.move = move;
+        report.nodes = engine.stats.total();
+        report.elapsedMs = engine.timeManager.getElapsedMs();
+        report.cancelled = engine.timeManager.stopRequested();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    busy = false;
+    return report;
+}
+
+SessionEngine::SessionEngine(int threads) : nextId(1), pool(threads) {}
+
+bool SessionEngine::loadNetwork(const char* path) {
+    std::shared_ptr<Nnue::Network> loaded(new Nnue::Network());
+    if(!loaded->load(path)) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    network = loaded;
+    return true;
+}
+
+int SessionEngine::open(const SessionOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int id = nextId++;
+    sessions[id] = std::make_shared<Session>(id, options, network);
+    return id;
+}
+
+bool SessionEngine::close(int id) {
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sessions.find(id);
+        if(it == sessions.end()) return false;
+        session = it->second;
+        sessions.erase(it);
+    }
+    session->cancel(); // A queued search still holds the session and reports as cancelled
+    return true;
+}
+
+std::shared_ptr<Session> SessionEngine::find(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = sessions.find(id);
+    return it == sessions.end() ? nullptr : it->second;
+}
+
+size_t SessionEngine::sessionCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sessions.size();
+}
+
+bool SessionEngine::go(int id, Callback done) {
+    std::shared_ptr<Session> session = find(id);
+    if(!session) return false;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if(session->busy) return false;
+        session->busy = true;
+        session->stopFlag = false;
+    }
+    pool.submit([session, done]() { done(session->search()); });
+    return true;
+}
+
+bool SessionEngine::stop(int id) {
+    std::shared_ptr<Session> session = find(id);
+    if(!session) return false;
+    session->cancel();
+    return true;
+}
@@ -0,0 +1,101 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "othello_engine.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Many independent games in one process. Each Session is one game with its
+// own search state and budgets; a SessionEngine owns the sessions, a shared
+// work-stealing ThreadPool that runs their searches, and an optional network
+// shared by all of them. Searches run as pool tasks in the order requested,
+// one at a time per session, and can be cancelled.
+
+struct SessionOptions {
+    size_t ttMegabytes = 16; // Transposition table size, rounded down to a power of two; 0 = engine default
+    int evalCacheBits = 12;  // Eval cache of 2^bits entries, used with a network
+    int timeMs = 1000;       // Per search, 0 = no time limit
+    int maxDepth = 20;
+    uint64_t maxNodes = 0;   // Per search, 0 = unlimited
+};
+
+struct SearchReport {
+    int session;
+    int move;        // -1: no legal move (pass)
+    uint64_t nodes;
+    int elapsedMs;
+    bool cancelled;  // Stopped by stop() or close() before the budget ran out
+};
+
+class Session {
+public:
+    Session(int id, const SessionOptions& options, std::shared_ptr<const Nnue::Network> network);
+
+    int id() const { return sessionId; }
+
+    // Game state. All return false while a search is running; play and
+    // setPosition also reject illegal input. After a move the side to move
+    // passes automatically if it has no legal move and the opponent has one.
+    bool newGame();
+    bool setPosition(uint64_t black, uint64_t white, int player);
+    bool play(int move);
+    bool snapshot(uint64_t& black, uint64_t& white, int& player) const;
+    bool legalMoves(std::vector<int>& moves) const;
+
+    // Searches the current position (with the session's budgets) on the
+    // calling thread; the move found is not played
+    SearchReport search();
+
+    void cancel() { stopFlag = true; }
+    bool searching() const;
+
+    size_t tableEntries() const { return engine.transTable.size(); }
+
+private:
+    friend class SessionEngine;
+
+    int sessionId;
+    SessionOptions options;
+    OthelloEngine engine;
+    int player;
+    bool busy; // A search is queued or running
+    std::atomic<bool> stopFlag;
+    mutable std::mutex mutex;
+
+    void passIfStuck();
+};
+
+class SessionEngine {
+public:
+    // threads <= 0 uses every core
+    explicit SessionEngine(int threads = 0);
+
+    // Shared by sessions opened afterwards; false if the file can't be loaded
+    bool loadNetwork(const char* path);
+
+    int open(const SessionOptions& options); // New session id
+    bool close(int id);                      // Cancels a running search
+    std::shared_ptr<Session> find(int id);
+    size_t sessionCount();
+
+    typedef std::function<void(const SearchReport&)> Callback;
+
+    // Queues a search for session id; done runs on a pool thread when it
+    // finishes. False if the session doesn't exist or is already searching.
+    bool go(int id, Callback done);
+    bool stop(int id);
+
+private:
+    std::mutex mutex;
+    std::map<int, std::shared_ptr<Session>> sessions;
+    int nextId;
+    std::shared_ptr<const Nnue::Network> network;
+    ThreadPool pool; // Last member: destroyed first, finishing queued searches
+};
+
+#endif // SESSION_H
@@ -0,0 +1,148 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Tasks submitted from outside the pool go to a
+// shared FIFO, so independent clients are served in arrival order. Tasks
+// submitted by a worker go to that worker's own deque, which it runs newest
+// first; idle workers steal the oldest task from the other deques. A thread
+// waiting on its own subtasks calls runOne() to help instead of blocking.
+class ThreadPool {
+public:
+    typedef std::function<void()> Task;
+
+    // threads <= 0 uses every core
+    explicit ThreadPool(int threads = 0) : stopping(false), pending(0) {
+        if(threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+        for(int i = 0; i < threads; ++i) queues.emplace_back(new WorkerQueue());
+        for(int i = 0; i < threads; ++i) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+
+    // Runs every task still queued, then joins the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return (int)workers.size();
+    }
+
+    void submit(Task task) {
+        int index = currentWorker();
+        if(index >= 0) {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        } else {
+            std::lock_guard<std::mutex> lock(sharedMutex);
+            shared.push_back(std::move(task));
+        }
+        pending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+
+    // Runs one queued task on the calling thread; false if none was found
+    bool runOne() {
+        Task task;
+        if(!take(currentWorker(), task)) return false;
+        task();
+        return true;
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sharedMutex;
+    std::deque<Task> shared;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping;
+    std::atomic<int> pending; // Tasks queued and not yet taken
+
+    // Worker index of the calling thread in this pool, -1 for other threads
+    struct WorkerId {
+        const ThreadPool* pool;
+        int index;
+    };
+
+    static WorkerId& workerId() {
+        static thread_local WorkerId id = {nullptr, -1};
+        return id;
+    }
+
+    int currentWorker() const {
+        const WorkerId& id = workerId();
+        return id.pool == this ? id.index : -1;
+    }
+
+    static bool popBack(WorkerQueue& queue, Task& task) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    static bool popFront(std::mutex& mutex, std::deque<Task>& tasks, Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(tasks.empty()) return false;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        return true;
+    }
+
+    // Own deque first, then the shared FIFO, then steal from the others
+    bool take(int index, Task& task) {
+        if(pending.load() <= 0) return false;
+        bool found = (index >= 0 && popBack(*queues[index], task)) || popFront(sharedMutex, shared, task);
+        size_t start = (size_t)(index + 1);
+        for(size_t i = 0; !found && i < queues.size(); ++i) {
+            WorkerQueue& victim = *queues[(start + i) % queues.size()];
+            found = popFront(victim.mutex, victim.tasks, task);
+        }
+        if(found) pending.fetch_sub(1);
+        return found;
+    }
+
+    void workerLoop(int index) {
+        WorkerId& id = workerId();
+        id.pool = this;
+        id.index = index;
+        for(;;) {
+            Task task;
+            if(take(index, task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]() { return stopping || pending.load() > 0; });
+            if(stopping && pending.load() <= 0) return;
+        }
+    }
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,22 @@
+#include "wthor.h"
+
+bool WthorFile::open(const char* path) {
+    close();
+    if(!file.open(path)) return false;
+    const unsigned char* header = file.data();
+    if(file.size() < Wthor::HeaderSize || (header[12] != 0 && header[12] != 8)) {
+        close();
+        return false;
+    }
+    uint32_t declared = (uint32_t)header[4] | (uint32_t)header[5] << 8 |
+                        (uint32_t)header[6] << 16 | (uint32_t)header[7] << 24;
+    // Trust the header only as far as the file really extends
+    size_t present = (file.size() - Wthor::HeaderSize) / Wthor::GameSize;
+    games = declared < present ? declared : (uint32_t)present;
+    return true;
+}
+
+void WthorFile::close() {
+    file.close();
+    games = 0;
+}
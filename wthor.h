@@ -0,0 +1,111 @@
+#ifndef WTHOR_H
+#define WTHOR_H
+
+#include "othello_board.h"
+#include "mapped_file.h"
+
+// WTHOR game databases (.wtb): a 16-byte header holding the game count as a
+// little-endian uint32 at offset 4 and the board size at offset 12 (0 or 8),
+// then 68-byte games. A game stores the tournament, black and white player
+// ids (uint16 each), black's final disc count, the theoretical score and 60
+// move bytes encoded row*10 + col -- the mailbox square -- with 0 after the
+// last move. Games start from the standard position, the mirror image of
+// OthelloBoard::initBoard.
+namespace Wthor {
+    const size_t HeaderSize = 16;
+    const size_t GameSize = 68;
+    const size_t MovesOffset = 8;
+    const int MaxMoves = 60;
+}
+
+// View of one game record inside a mapped file
+struct WthorGame {
+    const unsigned char* data;
+
+    int blackDiscs() const { return data[6]; }
+    int move(int index) const { return data[Wthor::MovesOffset + index]; }
+
+    // Result for black: 2 win, 1 draw, 0 loss
+    int blackPoints() const {
+        return blackDiscs() > 32 ? 2 : blackDiscs() == 32 ? 1 : 0;
+    }
+};
+
+class WthorFile {
+private:
+    MappedFile file;
+    uint32_t games;
+
+public:
+    WthorFile() : games(0) {}
+
+    // False if the file can't be mapped or is not an 8x8 WTHOR database
+    bool open(const char* path);
+    void close();
+
+    uint32_t count() const { return games; }
+    WthorGame game(uint32_t index) const {
+        WthorGame result = {file.data() + Wthor::HeaderSize + (size_t)index * Wthor::GameSize};
+        return result;
+    }
+};
+
+namespace Wthor {
+    // Discs indexed by player (OthelloBoard::BLACK/WHITE), set to the standard
+    // start position that WTHOR games are recorded from: white on d4 and e5
+    inline void startPosition(uint64_t discs[3]) {
+        discs[0] = 0;
+        discs[OthelloBoard::BLACK] = (1ULL << Bitboard::squareToBit(45)) | (1ULL << Bitboard::squareToBit(54));
+        discs[OthelloBoard::WHITE] = (1ULL << Bitboard::squareToBit(44)) | (1ULL << Bitboard::squareToBit(55));
+    }
+
+    // Plays move (a mailbox square) for player, or for the opponent if player
+    // must have passed; player becomes the side to move next. False if the move
+    // is illegal for both sides.
+    inline bool playMove(uint64_t discs[3], int& player, int move) {
+        if(move < 11 || move > 88 || move % 10 == 0 || move % 10 == 9) return false;
+        int bit = Bitboard::squareToBit(move);
+        uint64_t square = 1ULL << bit;
+        if((discs[1] | discs[2]) & square) return false;
+        uint64_t flipped = Bitboard::flips(discs[player], discs[3 - player], bit);
+        if(!flipped) {
+            player = 3 - player; // Pass
+            flipped = Bitboard::flips(discs[player], discs[3 - player], bit);
+            if(!flipped) return false;
+        }
+        discs[player] |= flipped | square;
+        discs[3 - player] &= ~flipped;
+        player = 3 - player;
+        return true;
+    }
+
+    // Side to move at the end of a move sequence: player unless only the
+    // opponent can move
+    inline int playerToMove(const uint64_t discs[3], int player) {
+        if(!Bitboard::legalMoves(discs[player], discs[3 - player]) &&
+           Bitboard::legalMoves(discs[3 - player], discs[player])) return 3 - player;
+        return player;
+    }
+
+    // Replays game on bitboards, calling visit(black, white, player, move)
+    // before each move and visit(black, white, player, 0) at the final
+    // position. Passes are inferred from move legality. Returns false at the
+    // first illegal or malformed move. Nothing is allocated.
+    template<class Visitor>
+    bool replayGame(const WthorGame& game, Visitor&& visit) {
+        uint64_t discs[3];
+        startPosition(discs);
+        int player = OthelloBoard::BLACK;
+        for(int i = 0; i < Wthor::MaxMoves; ++i) {
+            int move = game.move(i);
+            if(move == 0) break;
+            uint64_t black = discs[OthelloBoard::BLACK], white = discs[OthelloBoard::WHITE];
+            if(!playMove(discs, player, move)) return false;
+            visit(black, white, 3 - player, move); // The side that moved, after any pass
+        }
+        visit(discs[OthelloBoard::BLACK], discs[OthelloBoard::WHITE], playerToMove(discs, player), 0);
+        return true;
+    }
+}
+
+#endif // WTHOR_H